@@ -0,0 +1,540 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_ALG_ANNEALER_H
+#define TENACITAS_LIB_CROSSWORDS_ALG_ANNEALER_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <tenacitas.lib.crosswords/alg/assembler.h>
+#include <tenacitas.lib.crosswords/typ/grid.h>
+#include <tenacitas.lib.log/alg/logger.h>
+
+namespace tenacitas::lib::crosswords::bus {
+
+/// \brief Temperature schedule of \p basic_annealer that decreases
+/// exponentially from an initial to a final temperature
+///
+/// \details A temperature of 1 accepts removing one word with probability
+/// 1/e, so the initial temperature should be around 1, and the final one
+/// close to 0, when only moves that do not remove words are accepted
+struct exponential_cooling {
+  static constexpr double default_initial{1.0};
+  static constexpr double default_final{0.02};
+
+  exponential_cooling(double p_initial = default_initial,
+                      double p_final = default_final)
+      : m_initial(p_initial), m_ratio(p_final / p_initial) {}
+
+  /// \return temperature at step \p p_step of \p p_num_steps
+  inline double operator()(uint64_t p_step, uint64_t p_num_steps) const {
+    return m_initial * std::pow(m_ratio, static_cast<double>(p_step) /
+                                             static_cast<double>(p_num_steps));
+  }
+
+private:
+  double m_initial{default_initial};
+  double m_ratio{default_final / default_initial};
+};
+
+/// \brief Temperature schedule of \p basic_annealer that decreases linearly
+/// from an initial to a final temperature
+struct linear_cooling {
+  static constexpr double default_initial{1.0};
+  static constexpr double default_final{0.02};
+
+  linear_cooling(double p_initial = default_initial,
+                 double p_final = default_final)
+      : m_initial(p_initial), m_final(p_final) {}
+
+  /// \return temperature at step \p p_step of \p p_num_steps
+  inline double operator()(uint64_t p_step, uint64_t p_num_steps) const {
+    return m_initial + ((m_final - m_initial) * static_cast<double>(p_step) /
+                        static_cast<double>(p_num_steps));
+  }
+
+private:
+  double m_initial{default_initial};
+  double m_final{default_final};
+};
+
+namespace internal {
+
+/// \brief Informs if two positioned words share a cell
+template <typename t_grid>
+bool touch(typename t_grid::const_layout_ite p_l1,
+           typename t_grid::const_layout_ite p_l2) {
+  const bool _v1{p_l1->get_orientation() == typ::orientation::vert};
+  const bool _v2{p_l2->get_orientation() == typ::orientation::vert};
+  // line and first and last cell in the line, for each word
+  const typ::index _line1{_v1 ? p_l1->get_col() : p_l1->get_row()};
+  const typ::index _begin1{_v1 ? p_l1->get_row() : p_l1->get_col()};
+  const typ::index _end1{static_cast<typ::index>(_begin1 + p_l1->get_size())};
+  const typ::index _line2{_v2 ? p_l2->get_col() : p_l2->get_row()};
+  const typ::index _begin2{_v2 ? p_l2->get_row() : p_l2->get_col()};
+  const typ::index _end2{static_cast<typ::index>(_begin2 + p_l2->get_size())};
+
+  if (_v1 == _v2) {
+    return (_line1 == _line2) && (_begin1 < _end2) && (_begin2 < _end1);
+  }
+  return (_line2 >= _begin1) && (_line2 < _end1) && (_line1 >= _begin2) &&
+         (_line1 < _end2);
+}
+
+/// \brief A Markov chain of a simulated annealing that tries to position as
+/// many words as possible in a grid, all of them connected
+///
+/// \details The chain starts from a greedy grid, where the longest word is
+/// positioned at the center, and each other word, from the longest, is
+/// positioned crossing the words already positioned, at the place with more
+/// crossings, if there is one.
+///
+/// Each step then tries a move:
+/// - insert: a word not positioned is positioned crossing the others
+/// - relocate: a positioned word is removed and positioned crossing the
+///   others at another place
+/// - swap: a positioned word is removed, and a word not positioned is
+///   positioned in its place
+/// - remove: a positioned word is removed
+///
+/// A word is only removed if the others remain connected. The objective is
+/// the number of words positioned plus \p crossing_weight times the number of
+/// cells shared by two words, and it is updated with the change of each
+/// move. A move that improves it is always accepted, and one that worsens it
+/// by \f$\Delta\f$ is accepted with probability \f$e^{-\Delta/T}\f$, where
+/// \f$T\f$ is the temperature of the schedule at the step.
+template <typename t_grid> struct basic_annealing_chain {
+  using layout_ite = typename t_grid::layout_ite;
+  using const_layout_ite = typename t_grid::const_layout_ite;
+
+  /// \brief Value of a cell shared by two words, relative to a word
+  /// positioned
+  static constexpr double crossing_weight{0.1};
+
+  basic_annealing_chain(uint64_t p_seed = 0) : m_random(p_seed) {}
+
+  /// \brief Runs the chain
+  ///
+  /// \param p_stop polled during the chain, and set when all the words are
+  /// positioned, so the other chains stop
+  ///
+  /// \param p_grid grid where the words are positioned, with no word
+  /// positioned
+  ///
+  /// \param p_best receives a copy of \p p_grid each time the objective is
+  /// the best so far
+  ///
+  /// \param p_schedule temperature for each step
+  ///
+  /// \param p_num_steps number of steps of the chain
+  template <typename t_schedule>
+  void operator()(std::atomic<bool> &p_stop, t_grid &p_grid, t_grid &p_best,
+                  const t_schedule &p_schedule, uint64_t p_num_steps) {
+    m_stop = &p_stop;
+    m_num_words =
+        static_cast<size_t>(std::distance(p_grid.begin(), p_grid.end()));
+    m_positioned.clear();
+    m_waiting.clear();
+    m_objective = 0;
+    m_best = -1;
+
+    greedy(p_grid);
+    keep_best(p_grid, p_best);
+
+    for (m_step = 0;
+         (m_step < p_num_steps) && (m_positioned.size() < m_num_words);
+         ++m_step) {
+      if (((m_step & 0xFF) == 0) && p_stop.load(std::memory_order_relaxed)) {
+        return;
+      }
+      const double _temperature{p_schedule(m_step, p_num_steps)};
+      if (move(p_grid, _temperature)) {
+        keep_best(p_grid, p_best);
+      }
+    }
+
+    if (m_positioned.size() == m_num_words) {
+      TNCT_LOG_TRA("annealing chain ", this, ": all the words positioned in ",
+                   m_step, " steps");
+      p_stop = true;
+    }
+  }
+
+  /// \brief Number of steps run
+  inline uint64_t get_num_steps() const { return m_step; }
+
+  /// \brief Best objective reached
+  inline double get_best() const { return m_best; }
+
+private:
+  void greedy(t_grid &p_grid) {
+    std::vector<layout_ite> _words;
+    for (layout_ite _layout = p_grid.begin(); _layout != p_grid.end();
+         ++_layout) {
+      _words.push_back(_layout);
+    }
+    std::stable_sort(_words.begin(), _words.end(),
+                     [](layout_ite p_l1, layout_ite p_l2) {
+                       return p_l1->get_size() > p_l2->get_size();
+                     });
+
+    layout_ite _first{_words.front()};
+    if (_first->get_size() <= p_grid.get_num_cols()) {
+      set(p_grid, _first,
+          {static_cast<typ::index>(p_grid.get_num_rows() / 2),
+           static_cast<typ::index>(
+               (p_grid.get_num_cols() - _first->get_size()) / 2),
+           typ::orientation::hori});
+    } else {
+      set(p_grid, _first,
+          {static_cast<typ::index>(
+               (p_grid.get_num_rows() - _first->get_size()) / 2),
+           static_cast<typ::index>(p_grid.get_num_cols() / 2),
+           typ::orientation::vert});
+    }
+
+    for (auto _word = std::next(_words.begin()); _word != _words.end();
+         ++_word) {
+      crossing_candidates(*m_stop, p_grid, m_positioned, *_word, m_candidates);
+      if (m_candidates.empty()) {
+        m_waiting.push_back(*_word);
+        continue;
+      }
+      size_t _best{0};
+      size_t _best_crossings{0};
+      for (size_t _i = 0; _i < m_candidates.size(); ++_i) {
+        const size_t _crossings{
+            crossings(p_grid, (*_word)->get_size(), m_candidates[_i])};
+        if (_crossings > _best_crossings) {
+          _best = _i;
+          _best_crossings = _crossings;
+        }
+      }
+      set(p_grid, *_word, m_candidates[_best]);
+    }
+  }
+
+  /// \return if the move was accepted
+  bool move(t_grid &p_grid, double p_temperature) {
+    if (!m_waiting.empty() && (uniform() < 0.5)) {
+      return insert(p_grid, pick(m_waiting));
+    }
+    if (m_positioned.size() < 2) {
+      return false;
+    }
+
+    const size_t _positioned{pick(m_positioned.size() - 1) + 1};
+    layout_ite _word{writable(p_grid, m_positioned[_positioned])};
+    const placement _from{_word->get_row(), _word->get_col(),
+                          _word->get_orientation()};
+    const double _before{m_objective};
+    unset(p_grid, _positioned);
+    if (!connected()) {
+      set(p_grid, _word, _from);
+      m_waiting.pop_back();
+      return false;
+    }
+
+    layout_ite _other{_word};
+    const double _kind{uniform()};
+    if ((m_waiting.size() > 1) && (_kind < 0.4)) {
+      // swap
+      _other = m_waiting[pick(m_waiting.size() - 1)];
+    } else if (_kind < 0.8) {
+      // relocate
+    } else {
+      // remove
+      _other = p_grid.end();
+    }
+
+    if (_other != p_grid.end()) {
+      crossing_candidates(*m_stop, p_grid, m_positioned, _other, m_candidates);
+      if (_other == _word) {
+        m_candidates.erase(
+            std::remove(m_candidates.begin(), m_candidates.end(), _from),
+            m_candidates.end());
+      }
+      if (m_candidates.empty()) {
+        _other = p_grid.end();
+      } else {
+        set(p_grid, _other, m_candidates[pick(m_candidates.size())]);
+        take(_other);
+      }
+    }
+
+    const double _delta{m_objective - _before};
+    if ((_delta >= 0) || (uniform() < std::exp(_delta / p_temperature))) {
+      return _delta > 0;
+    }
+
+    // undo
+    if (_other != p_grid.end()) {
+      unset(p_grid, m_positioned.size() - 1);
+    }
+    set(p_grid, _word, _from);
+    take(_word);
+    return false;
+  }
+
+  bool insert(t_grid &p_grid, size_t p_waiting) {
+    layout_ite _word{m_waiting[p_waiting]};
+    crossing_candidates(*m_stop, p_grid, m_positioned, _word, m_candidates);
+    if (m_candidates.empty()) {
+      return false;
+    }
+    m_waiting[p_waiting] = m_waiting.back();
+    m_waiting.pop_back();
+    set(p_grid, _word, m_candidates[pick(m_candidates.size())]);
+    return true;
+  }
+
+  /// \brief Positions a word, updating the objective
+  void set(t_grid &p_grid, layout_ite p_word, const placement &p_placement) {
+    m_objective +=
+        1 + crossing_weight * static_cast<double>(crossings(
+                                  p_grid, p_word->get_size(), p_placement));
+    p_grid.set(p_word, p_placement.row, p_placement.col,
+               p_placement.orientation);
+    m_positioned.push_back(p_word);
+  }
+
+  /// \brief Removes the positioned word at \p p_positioned, updating the
+  /// objective, and moves it to the end of the words waiting
+  void unset(t_grid &p_grid, size_t p_positioned) {
+    layout_ite _word{writable(p_grid, m_positioned[p_positioned])};
+    const placement _placement{_word->get_row(), _word->get_col(),
+                               _word->get_orientation()};
+    p_grid.unset(_word);
+    m_objective -=
+        1 + crossing_weight * static_cast<double>(crossings(
+                                  p_grid, _word->get_size(), _placement));
+    m_positioned[p_positioned] = m_positioned.back();
+    m_positioned.pop_back();
+    m_waiting.push_back(_word);
+  }
+
+  /// \brief Removes a word that was just positioned from the words waiting
+  void take(layout_ite p_word) {
+    auto _ite{std::find(m_waiting.begin(), m_waiting.end(), p_word)};
+    *_ite = m_waiting.back();
+    m_waiting.pop_back();
+  }
+
+  static inline layout_ite writable(t_grid &p_grid, const_layout_ite p_word) {
+    return p_grid.begin() + (p_word - p_grid.begin());
+  }
+
+  /// \brief Number of occupied cells a word would cover at a place
+  size_t crossings(const t_grid &p_grid, typ::index p_size,
+                   const placement &p_placement) const {
+    const bool _vertical{p_placement.orientation == typ::orientation::vert};
+    size_t _crossings{0};
+    for (typ::index _i = 0; _i < p_size; ++_i) {
+      if (p_grid.is_occupied(
+              static_cast<typ::index>(p_placement.row + (_vertical ? _i : 0)),
+              static_cast<typ::index>(p_placement.col +
+                                      (_vertical ? 0 : _i)))) {
+        ++_crossings;
+      }
+    }
+    return _crossings;
+  }
+
+  /// \brief Informs if all the positioned words are connected by shared
+  /// cells
+  bool connected() {
+    const size_t _size{m_positioned.size()};
+    m_reached.assign(_size, false);
+    m_queue.clear();
+    m_queue.push_back(0);
+    m_reached[0] = true;
+    for (size_t _next = 0; _next < m_queue.size(); ++_next) {
+      const_layout_ite _word{m_positioned[m_queue[_next]]};
+      for (size_t _i = 0; _i < _size; ++_i) {
+        if (!m_reached[_i] && touch<t_grid>(_word, m_positioned[_i])) {
+          m_reached[_i] = true;
+          m_queue.push_back(_i);
+        }
+      }
+    }
+    return m_queue.size() == _size;
+  }
+
+  void keep_best(const t_grid &p_grid, t_grid &p_best) {
+    if (m_objective > m_best) {
+      m_best = m_objective;
+      p_best = p_grid;
+    }
+  }
+
+  inline double uniform() {
+    return std::uniform_real_distribution<double>{0.0, 1.0}(m_random);
+  }
+
+  inline size_t pick(size_t p_size) {
+    return std::uniform_int_distribution<size_t>{0, p_size - 1}(m_random);
+  }
+
+  template <typename t_collection>
+  inline size_t pick(const t_collection &p_collection) {
+    return pick(p_collection.size());
+  }
+
+private:
+  std::mt19937_64 m_random;
+  /// \brief Flag given to \p operator(), polled while looking for places
+  std::atomic<bool> *m_stop{nullptr};
+  size_t m_num_words{0};
+  uint64_t m_step{0};
+  double m_objective{0};
+  double m_best{-1};
+
+  /// \brief Words positioned, where the first one is never removed
+  std::vector<const_layout_ite> m_positioned;
+
+  /// \brief Words not positioned
+  std::vector<layout_ite> m_waiting;
+
+  std::vector<placement> m_candidates;
+  std::vector<bool> m_reached;
+  std::vector<size_t> m_queue;
+};
+
+} // namespace internal
+
+/// \brief Positions as many words as possible in a grid, with independent
+/// simulated annealing chains in parallel
+///
+/// \details An alternative to \p basic_assembler when there are too many
+/// words for a complete search, like 40 or more. The grid returned has all
+/// the words positioned connected, but may not have all the words positioned.
+///
+/// \tparam t_grid type of grid, like \p typ::grid, or \p typ::fixed_grid
+///
+/// \tparam t_schedule temperature for each step, like
+/// \p exponential_cooling or \p linear_cooling
+template <typename t_grid, typename t_schedule = exponential_cooling>
+struct basic_annealer {
+  /// \brief Default number of steps of each chain
+  static constexpr uint64_t default_num_steps{200000};
+
+  basic_annealer(uint64_t p_num_steps = default_num_steps,
+                 t_schedule p_schedule = t_schedule{})
+      : m_num_steps(p_num_steps), m_schedule(p_schedule) {}
+
+  basic_annealer(const basic_annealer &) = delete;
+  basic_annealer(basic_annealer &&) = delete;
+  basic_annealer &operator=(const basic_annealer &) = delete;
+  basic_annealer &operator=(basic_annealer &&) = delete;
+  ~basic_annealer() = default;
+
+  /// \brief Positions the words of \p p_entries in a grid
+  ///
+  /// \param p_entries entries used to assemble the grid
+  ///
+  /// \param p_num_rows number of rows of the grid
+  ///
+  /// \param p_num_cols number of columns of the grid
+  ///
+  /// \param p_num_chains number of chains, each one in a thread
+  ///
+  /// \param p_seed seed of the first chain, and the others are derived from
+  /// it
+  ///
+  /// \return the grid with the best objective of all the chains, or
+  /// \p nullptr if it was not possible to create the grid
+  std::shared_ptr<t_grid>
+  start(const typ::entries &p_entries, typ::index p_num_rows,
+        typ::index p_num_cols,
+        size_t p_num_chains = std::max(std::thread::hardware_concurrency(), 1U),
+        uint64_t p_seed = 0) {
+    m_stop = false;
+    m_entries = p_entries;
+
+    typ::permutation _permutation;
+    for (typ::entries::const_entry_ite _entry = m_entries.begin();
+         _entry != m_entries.end(); ++_entry) {
+      _permutation.push_back(_entry);
+    }
+    if (_permutation.empty()) {
+      TNCT_LOG_ERR("no words to position");
+      return nullptr;
+    }
+
+    std::vector<t_grid> _grids;
+    std::vector<t_grid> _bests;
+    try {
+      std::shared_ptr<typ::alphabet> _alphabet{
+          std::make_shared<typ::alphabet>()};
+      for (const typ::entry &_entry : m_entries) {
+        _alphabet->add(_entry.get_word());
+      }
+      for (size_t _i = 0; _i < p_num_chains; ++_i) {
+        _grids.emplace_back(_permutation, _alphabet, p_num_rows, p_num_cols);
+      }
+    } catch (std::exception &_ex) {
+      TNCT_LOG_ERR(_ex.what());
+      return nullptr;
+    }
+    _bests = _grids;
+
+    m_chains.clear();
+    for (size_t _i = 0; _i < p_num_chains; ++_i) {
+      m_chains.emplace_back(typ::mix(p_seed + _i));
+    }
+
+    std::vector<std::thread> _threads;
+    for (size_t _i = 0; _i < p_num_chains; ++_i) {
+      _threads.emplace_back([this, _i, &_grids, &_bests]() {
+        m_chains[_i](m_stop, _grids[_i], _bests[_i], m_schedule, m_num_steps);
+      });
+    }
+    for (std::thread &_thread : _threads) {
+      _thread.join();
+    }
+
+    size_t _best{0};
+    for (size_t _i = 1; _i < p_num_chains; ++_i) {
+      if (m_chains[_i].get_best() > m_chains[_best].get_best()) {
+        _best = _i;
+      }
+    }
+    TNCT_LOG_TRA("annealer: best objective ", m_chains[_best].get_best(),
+                 " in chain ", _best);
+    return std::make_shared<t_grid>(std::move(_bests[_best]));
+  }
+
+  /// \brief Stops the chains
+  inline void stop() { m_stop = true; }
+
+  /// \brief Number of steps run by all the chains in the last \p start
+  uint64_t get_num_steps() const {
+    uint64_t _steps{0};
+    for (const internal::basic_annealing_chain<t_grid> &_chain : m_chains) {
+      _steps += _chain.get_num_steps();
+    }
+    return _steps;
+  }
+
+private:
+  uint64_t m_num_steps{default_num_steps};
+  t_schedule m_schedule;
+  std::atomic<bool> m_stop{false};
+  typ::entries m_entries;
+  std::vector<internal::basic_annealing_chain<t_grid>> m_chains;
+};
+
+using annealer = basic_annealer<typ::grid>;
+
+} // namespace tenacitas::lib::crosswords::bus
+
+#endif
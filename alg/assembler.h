@@ -7,18 +7,26 @@
 /// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <optional>
+#include <queue>
+#include <random>
+#include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <tenacitas.lib.container/typ/matrix.h>
 #include <tenacitas.lib.crosswords/evt/events.h>
 #include <tenacitas.lib.crosswords/typ/grid.h>
+#include <tenacitas.lib.crosswords/typ/nogood_store.h>
+#include <tenacitas.lib.crosswords/typ/transposition_table.h>
 #include <tenacitas.lib.log/alg/logger.h>
 #include <tenacitas.lib.math/alg/factorial.h>
 #include <tenacitas.lib.number/alg/format.h>
@@ -27,13 +35,13 @@ namespace tenacitas::lib::crosswords::bus {
 
 namespace internal {
 
-bool all_words_fit(const typ::grid &p_grid) {
+template <typename t_grid> bool all_words_fit(const t_grid &p_grid) {
   using namespace typ;
   index _row_size{p_grid.get_num_rows()};
   index _col_size{p_grid.get_num_cols()};
 
-  typ::grid::const_layout_ite _end = p_grid.end();
-  for (grid::const_layout_ite _layout = p_grid.begin(); _layout != _end;
+  typename t_grid::const_layout_ite _end = p_grid.end();
+  for (typename t_grid::const_layout_ite _layout = p_grid.begin(); _layout != _end;
        ++_layout) {
     index _word_size{typ::get_size(_layout->get_word())};
     if ((_word_size > _row_size) && (_word_size > _col_size)) {
@@ -45,13 +53,13 @@ bool all_words_fit(const typ::grid &p_grid) {
   return true;
 }
 
-typ::index longest_word(const typ::grid &p_grid) {
+template <typename t_grid> typ::index longest_word(const t_grid &p_grid) {
   using namespace typ;
   index _size{0};
 
-  grid::const_layout_ite _end{p_grid.end()};
+  typename t_grid::const_layout_ite _end{p_grid.end()};
 
-  for (grid::const_layout_ite _layout = p_grid.begin(); _layout != _end;
+  for (typename t_grid::const_layout_ite _layout = p_grid.begin(); _layout != _end;
        ++_layout) {
     auto _word_size{typ::get_size(_layout->get_word())};
     if (_word_size > _size) {
@@ -61,20 +69,16 @@ typ::index longest_word(const typ::grid &p_grid) {
   return _size;
 }
 
-struct first_word_positioner {
-  bool operator()(bool &p_stop, typ::grid &p_grid) {
-    if (m_occupied.get_num_rows() == 0) {
-      //      const auto _longest{typ::get_size(p_grid.begin()->get_word())};
-      //      auto _num_rows{p_grid.get_num_rows()};
-      //      auto _num_cols{p_grid.get_num_cols()};
-      //      if (_num_rows > _longest) {
-      //        _num_rows -= _longest;
-      //      }
-      //      if (_num_cols > _longest) {
-      //        _num_cols -= _longest;
-      //      }
-      m_occupied = typ::occupied(p_grid.get_num_rows(), p_grid.get_num_cols(),
-                                 typ::max_char);
+/// \brief Positions the first word of a grid, trying each cell
+/// horizontally, from the first row, and then each cell vertically
+///
+/// \tparam t_grid type of grid, like \p typ::grid or \p typ::fixed_grid
+template <typename t_grid> struct basic_first_word_positioner {
+  bool operator()(std::atomic<bool> &p_stop, t_grid &p_grid) {
+    if (!m_initialized) {
+      m_dimensions = p_grid.get_dimensions();
+      m_tried = m_dimensions.create_cells();
+      m_initialized = true;
     }
     if (p_stop) {
       return false;
@@ -83,7 +87,7 @@ struct first_word_positioner {
       return true;
     }
     if (!m_vertical) {
-      m_occupied.reset();
+      m_tried = m_dimensions.create_cells();
       m_vertical = true;
     }
     if (p_stop) {
@@ -93,13 +97,20 @@ struct first_word_positioner {
   }
 
 private:
-  bool horizontal(bool &p_stop, typ::grid &p_grid) {
+  using dimensions = typename t_grid::dimensions;
+
+private:
+  inline size_t pos(typ::index p_row, typ::index p_col) const {
+    return static_cast<size_t>(p_row) * m_dimensions.get_num_cols() + p_col;
+  }
+
+  bool horizontal(std::atomic<bool> &p_stop, t_grid &p_grid) {
     using namespace typ;
 
-    const index _num_rows{m_occupied.get_num_rows()};
-    const index _num_cols{m_occupied.get_num_rows()};
+    const index _num_rows{m_dimensions.get_num_rows()};
+    const index _num_cols{m_dimensions.get_num_cols()};
     auto _layout = p_grid.begin();
-    const auto _word_size{typ::get_size(_layout->get_word())};
+    const auto _word_size{_layout->get_size()};
 
     bool _set{false};
 
@@ -109,9 +120,9 @@ private:
         if ((_col + _word_size) > _num_cols) {
           break;
         }
-        if (m_occupied(_row, _col) == typ::max_char) {
+        if (m_tried[pos(_row, _col)] == typ::max_char) {
           p_grid.set(_layout, _row, _col, typ::orientation::hori);
-          m_occupied(_row, _col) = '#';
+          m_tried[pos(_row, _col)] = '#';
           _set = true;
         }
       }
@@ -122,13 +133,13 @@ private:
     return _set;
   }
 
-  bool vertical(bool &p_stop, typ::grid &p_grid) {
+  bool vertical(std::atomic<bool> &p_stop, t_grid &p_grid) {
     using namespace typ;
 
-    const index _num_rows{m_occupied.get_num_rows()};
-    const index _num_cols{m_occupied.get_num_rows()};
+    const index _num_rows{m_dimensions.get_num_rows()};
+    const index _num_cols{m_dimensions.get_num_cols()};
     auto _layout = p_grid.begin();
-    const auto _word_size{typ::get_size(_layout->get_word())};
+    const auto _word_size{_layout->get_size()};
 
     bool _set{false};
 
@@ -138,9 +149,9 @@ private:
           break;
         }
 
-        if (m_occupied(_row, _col) == typ::max_char) {
+        if (m_tried[pos(_row, _col)] == typ::max_char) {
           p_grid.set(_layout, _row, _col, typ::orientation::vert);
-          m_occupied(_row, _col) = '#';
+          m_tried[pos(_row, _col)] = '#';
           _set = true;
         }
       }
@@ -149,35 +160,206 @@ private:
   }
 
 private:
+  bool m_initialized{false};
   bool m_all_horizontal_tried{false};
   bool m_vertical{false};
-  typ::occupied m_occupied;
+  dimensions m_dimensions;
+
+  /// \brief Cells where the first word was already positioned
+  typename dimensions::cells m_tried;
+};
+
+using first_word_positioner = basic_first_word_positioner<typ::grid>;
+
+/// \brief Order in which \p basic_canonical_positioner tries the places of
+/// the first word
+enum class anchor_order : char {
+  /// \brief row by row
+  row_major,
+  /// \brief closer to the center of the grid first, as an organized grid
+  /// that does not use all the rows or columns can be shifted, and a shift
+  /// with the first word near the center is the one more likely to fit
+  center_out,
+  /// \brief shuffled, so searches restarted with different seeds start from
+  /// different places
+  random
+};
+
+/// \brief Positions the first word of a grid only in places that are not
+/// symmetric to places already tried
+///
+/// \details When the grid is square, transposing an organized grid gives
+/// another organized grid, with the first word in the other orientation, so
+/// the first word is only positioned horizontally. When it is not, the
+/// transposed grid has other dimensions, and all the places are tried.
+///
+/// Mirroring the rows, or the columns, is not a symmetry, as it reverses the
+/// vertical, or the horizontal, words, and neither is a half turn, which
+/// reverses all the words, or a quarter turn, which also mirrors. Shifting an
+/// organized grid that does not use all the rows or columns gives another
+/// one, but with all the words shifted, so no place of the first word can be
+/// skipped: only the order in which they are tried can favor the shifts more
+/// likely to fit, like \p anchor_order::center_out.
+///
+/// \tparam t_grid type of grid, like \p typ::grid or \p typ::fixed_grid
+///
+/// \tparam t_order order in which the places are tried; see \p anchor_order
+template <typename t_grid, anchor_order t_order = anchor_order::row_major>
+struct basic_canonical_positioner {
+  /// \brief Sets the seed of the generator used to shuffle the places, when
+  /// \p t_order is \p anchor_order::random
+  inline void seed(uint64_t p_seed) { m_random.seed(p_seed); }
+
+  bool operator()(std::atomic<bool> &p_stop, t_grid &p_grid) {
+    if (!m_initialized) {
+      anchors(p_grid);
+      m_initialized = true;
+    }
+    if (p_stop || (m_next == m_anchors.size())) {
+      return false;
+    }
+    const anchor &_anchor{m_anchors[m_next++]};
+    p_grid.set(p_grid.begin(), _anchor.row, _anchor.col, _anchor.orientation);
+    return true;
+  }
+
+  /// \brief Number of places where the first word is positioned
+  inline size_t get_num_anchors() const { return m_anchors.size(); }
+
+private:
+  struct anchor {
+    typ::index row;
+    typ::index col;
+    typ::orientation orientation;
+  };
+
+private:
+  void anchors(const t_grid &p_grid) {
+    const typ::index _num_rows{p_grid.get_num_rows()};
+    const typ::index _num_cols{p_grid.get_num_cols()};
+    const typ::index _size{p_grid.begin()->get_size()};
+
+    for (typ::index _row = 0; _row < _num_rows; ++_row) {
+      for (typ::index _col = 0; _col + _size <= _num_cols; ++_col) {
+        m_anchors.push_back({_row, _col, typ::orientation::hori});
+      }
+    }
+    if (_num_rows != _num_cols) {
+      for (typ::index _row = 0; _row + _size <= _num_rows; ++_row) {
+        for (typ::index _col = 0; _col < _num_cols; ++_col) {
+          m_anchors.push_back({_row, _col, typ::orientation::vert});
+        }
+      }
+    }
+
+    if constexpr (t_order == anchor_order::center_out) {
+      // distances are doubled, so the center of the word and of the grid are
+      // integers
+      auto _distance = [&](const anchor &p_anchor) {
+        const bool _vertical{p_anchor.orientation == typ::orientation::vert};
+        const int _row{2 * p_anchor.row + (_vertical ? _size - 1 : 0)};
+        const int _col{2 * p_anchor.col + (_vertical ? 0 : _size - 1)};
+        const int _rows{_row - (_num_rows - 1)};
+        const int _cols{_col - (_num_cols - 1)};
+        return (_rows * _rows) + (_cols * _cols);
+      };
+      std::stable_sort(m_anchors.begin(), m_anchors.end(),
+                       [&](const anchor &p_a1, const anchor &p_a2) {
+                         return _distance(p_a1) < _distance(p_a2);
+                       });
+    } else if constexpr (t_order == anchor_order::random) {
+      std::shuffle(m_anchors.begin(), m_anchors.end(), m_random);
+    }
+  }
+
+private:
+  bool m_initialized{false};
+  std::vector<anchor> m_anchors;
+  size_t m_next{0};
+  std::mt19937_64 m_random;
 };
 
-typ::coordinates find_intersections(bool &p_stop, const typ::word &p_positioned,
-                                    const typ::word &p_to_position) {
+/// \brief Calls a function for each pair of equal letters in two words coded
+/// by the same \p typ::alphabet
+///
+/// \details When both words have up to \p typ::simd::max_intersection_size
+/// letters, the pairs are found with \p typ::simd::intersections, and the
+/// bits of the masks are iterated, without allocating memory
+///
+/// \param p_function called with a \p typ::coordinate where \p first is the
+/// index of the letter in \p p_to_position, and \p second is the index of
+/// the letter in \p p_positioned; if it returns \p true, the iteration stops
+template <typename t_function>
+void for_each_intersection(std::atomic<bool> &p_stop,
+                           const typ::letters &p_positioned,
+                           const typ::letters &p_to_position,
+                           t_function p_function) {
   using namespace typ;
 
-  coordinates _coordinates;
+  const index _positioned_size{static_cast<index>(p_positioned.size())};
+  const index _to_position_size{static_cast<index>(p_to_position.size())};
 
-  index _w1_size{typ::get_size(p_positioned)};
-  index _w2_size{typ::get_size(p_to_position)};
+  if ((_positioned_size <= index{simd::max_intersection_size}) &&
+      (_to_position_size <= index{simd::max_intersection_size})) {
+    std::array<uint32_t, simd::max_intersection_size> _masks;
+    if (!simd::intersections(p_positioned.data(), p_positioned.size(),
+                             p_to_position.data(), p_to_position.size(),
+                             _masks.data())) {
+      return;
+    }
+    for (index _i = 0; !p_stop && (_i < _positioned_size); ++_i) {
+      for (uint32_t _bits = _masks[_i]; !p_stop && (_bits != 0);
+           _bits &= _bits - 1) {
+        const index _j{static_cast<index>(__builtin_ctz(_bits))};
+        if (p_function(coordinate{_j, _i})) {
+          return;
+        }
+      }
+    }
+    return;
+  }
 
-  for (index _i2 = 0; !p_stop && (_i2 < _w2_size); ++_i2) {
-    for (index _i1 = 0; !p_stop && (_i1 < _w1_size); ++_i1) {
-      if (p_positioned[_i2] == p_to_position[_i1]) {
-        _coordinates.push_back({_i1, _i2});
+  for (index _i = 0; !p_stop && (_i < _positioned_size); ++_i) {
+    for (index _j = 0; !p_stop && (_j < _to_position_size); ++_j) {
+      if (p_positioned[_i] == p_to_position[_j]) {
+        if (p_function(coordinate{_j, _i})) {
+          return;
+        }
       }
     }
   }
+}
+
+/// \brief All the pairs of equal letters in two words coded by the same
+/// \p typ::alphabet, as \p for_each_intersection finds them
+///
+/// \details The letters are not coded here, so only the coordinates returned
+/// are allocated; the words of a grid are already coded by its alphabet
+typ::coordinates find_intersections(std::atomic<bool> &p_stop,
+                                    const typ::letters &p_positioned,
+                                    const typ::letters &p_to_position) {
+  using namespace typ;
+
+  coordinates _coordinates;
+
+  for_each_intersection(p_stop, p_positioned, p_to_position,
+                        [&_coordinates](const coordinate &p_coordinate) {
+                          _coordinates.push_back(p_coordinate);
+                          return false;
+                        });
 
   return _coordinates;
 }
 
-bool position_horizontally(typ::grid &p_grid,
-                           const typ::coordinate &p_intersect,
-                           typ::grid::const_layout_ite p_positioned,
-                           typ::grid::layout_ite p_to_position) {
+/// \brief Row and column where the word of \p p_to_position would start,
+/// horizontally, crossing \p p_positioned at \p p_intersect
+///
+/// \return the row and column, if the word fits there
+template <typename t_grid>
+std::optional<typ::coordinate>
+horizontal_candidate(const t_grid &p_grid, const typ::coordinate &p_intersect,
+                     typename t_grid::const_layout_ite p_positioned,
+                     typename t_grid::const_layout_ite p_to_position) {
   using namespace typ;
 
   auto _to_position_idx{p_intersect.first};
@@ -188,32 +370,31 @@ bool position_horizontally(typ::grid &p_grid,
   index _col_to_position(p_positioned->get_col() - _to_position_idx);
 
   if (_col_to_position < 0) {
-    return false;
+    return {};
   }
 
-  const index _word_size{typ::get_size(p_to_position->get_word())};
+  const index _word_size{p_to_position->get_size()};
   const index _col_end = _col_to_position + _word_size;
   if (_col_end > p_grid.get_num_cols()) {
-    return false;
+    return {};
   }
 
-  index _count{0};
-  const word &_word{p_to_position->get_word()};
-  for (auto _c : _word) {
-    const auto _maybe{
-        p_grid.is_occupied(_row_to_position, _col_to_position + _count++)};
-    if (_maybe && (_maybe.value() != _c)) {
-      return false;
-    }
+  if (!p_grid.fits_horizontally(_row_to_position, _col_to_position,
+                                p_to_position)) {
+    return {};
   }
-  p_grid.set(p_to_position, _row_to_position, _col_to_position,
-             orientation::hori);
-  return true;
+  return coordinate{_row_to_position, _col_to_position};
 }
 
-bool position_vertically(typ::grid &p_grid, const typ::coordinate &p_intersect,
-                         typ::grid::const_layout_ite p_positioned,
-                         typ::grid::layout_ite p_to_position) {
+/// \brief Row and column where the word of \p p_to_position would start,
+/// vertically, crossing \p p_positioned at \p p_intersect
+///
+/// \return the row and column, if the word fits there
+template <typename t_grid>
+std::optional<typ::coordinate>
+vertical_candidate(const t_grid &p_grid, const typ::coordinate &p_intersect,
+                   typename t_grid::const_layout_ite p_positioned,
+                   typename t_grid::const_layout_ite p_to_position) {
   using namespace typ;
 
   const index _to_position_idx{p_intersect.first};
@@ -224,61 +405,79 @@ bool position_vertically(typ::grid &p_grid, const typ::coordinate &p_intersect,
   const index _row_to_position(p_positioned->get_row() - _to_position_idx);
 
   if (_row_to_position < 0) {
-    return false;
+    return {};
   }
 
-  const index _word_size{typ::get_size(p_to_position->get_word())};
+  const index _word_size{p_to_position->get_size()};
   const index _row_end = _row_to_position + _word_size;
 
   if (_row_end > p_grid.get_num_rows()) {
+    return {};
+  }
+  if (!p_grid.fits_vertically(_row_to_position, _col_to_position,
+                              p_to_position)) {
+    return {};
+  }
+  return coordinate{_row_to_position, _col_to_position};
+}
+
+template <typename t_grid>
+bool position_horizontally(t_grid &p_grid, const typ::coordinate &p_intersect,
+                           typename t_grid::const_layout_ite p_positioned,
+                           typename t_grid::layout_ite p_to_position) {
+  const auto _candidate{
+      horizontal_candidate(p_grid, p_intersect, p_positioned, p_to_position)};
+  if (!_candidate) {
     return false;
   }
-  index _count{0};
-  const word &_word{p_to_position->get_word()};
-  for (auto _c : _word) {
-    const auto _maybe{
-        p_grid.is_occupied(_row_to_position + _count++, _col_to_position)};
-    if (_maybe && (_maybe.value() != _c)) {
-      return false;
-    }
+  p_grid.set(p_to_position, _candidate->first, _candidate->second,
+             typ::orientation::hori);
+  return true;
+}
+
+template <typename t_grid>
+bool position_vertically(t_grid &p_grid, const typ::coordinate &p_intersect,
+                         typename t_grid::const_layout_ite p_positioned,
+                         typename t_grid::layout_ite p_to_position) {
+  const auto _candidate{
+      vertical_candidate(p_grid, p_intersect, p_positioned, p_to_position)};
+  if (!_candidate) {
+    return false;
   }
-  p_grid.set(p_to_position, _row_to_position, _col_to_position,
-             orientation::vert);
+  p_grid.set(p_to_position, _candidate->first, _candidate->second,
+             typ::orientation::vert);
   return true;
 }
 
-bool position(bool &p_stop, typ::grid &p_grid,
-              typ::grid::const_layout_ite p_positioned,
-              typ::grid::layout_ite p_to_position) {
+template <typename t_grid>
+bool position(std::atomic<bool> &p_stop, t_grid &p_grid,
+              typename t_grid::const_layout_ite p_positioned,
+              typename t_grid::layout_ite p_to_position) {
   using namespace typ;
 
-  auto _intersects{internal::find_intersections(
-      p_stop, p_positioned->get_word(), p_to_position->get_word())};
-  auto _orientation{p_positioned->get_orientation()};
+  bool _positioned{false};
+  const bool _vertically{p_positioned->get_orientation() == orientation::hori};
+
+  internal::for_each_intersection(
+      p_stop, p_positioned->get_letters(), p_to_position->get_letters(),
+      [&](const coordinate &p_coord) {
+        _positioned = _vertically
+                          ? internal::position_vertically(
+                                p_grid, p_coord, p_positioned, p_to_position)
+                          : internal::position_horizontally(
+                                p_grid, p_coord, p_positioned, p_to_position);
+        return _positioned;
+      });
 
-  if (_orientation == orientation::hori) {
-    for (auto _coord : _intersects) {
-      if (internal::position_vertically(p_grid, _coord, p_positioned,
-                                        p_to_position)) {
-        return true;
-      }
-    }
-  } else {
-    for (auto _coord : _intersects) {
-      if (internal::position_horizontally(p_grid, _coord, p_positioned,
-                                          p_to_position)) {
-        return true;
-      }
-    }
-  }
-  return false;
+  return _positioned;
 }
 
-bool position(bool &p_stop, typ::grid &p_grid,
-              typ::grid::layout_ite p_to_position) {
+template <typename t_grid>
+bool position(std::atomic<bool> &p_stop, t_grid &p_grid,
+              typename t_grid::layout_ite p_to_position) {
   using namespace typ;
 
-  grid::layout_ite _positioned = std::next(p_grid.begin());
+  typename t_grid::layout_ite _positioned = std::next(p_grid.begin());
 
   while (_positioned != p_to_position) {
     if (!internal::position(p_stop, p_grid, p_to_position, _positioned)) {
@@ -290,26 +489,323 @@ bool position(bool &p_stop, typ::grid &p_grid,
   return true;
 }
 
-bool two_first_words_intersect(bool &p_stop, const typ::grid &p_grid) {
+/// \brief Where a word can be positioned
+struct placement {
+  typ::index row{typ::max_row};
+  typ::index col{typ::max_col};
+  typ::orientation orientation{typ::orientation::undef};
+
+  inline bool operator==(const placement &p_placement) const {
+    return (row == p_placement.row) && (col == p_placement.col) &&
+           (orientation == p_placement.orientation);
+  }
+};
+
+/// \brief All the places where the word of \p p_to_position fits crossing
+/// any of the words in \p p_positioned, without repetition, in the order
+/// the intersections are found
+template <typename t_grid>
+void crossing_candidates(
+    std::atomic<bool> &p_stop, const t_grid &p_grid,
+    const std::vector<typename t_grid::const_layout_ite> &p_positioned,
+    typename t_grid::const_layout_ite p_to_position,
+    std::vector<placement> &p_candidates) {
   using namespace typ;
-  grid::const_layout_ite _layout = p_grid.begin();
-  grid::const_layout_ite _to_position = std::next(p_grid.begin());
+
+  p_candidates.clear();
+  for (typename t_grid::const_layout_ite _layout : p_positioned) {
+    const bool _vertically{_layout->get_orientation() == orientation::hori};
+    for_each_intersection(
+        p_stop, _layout->get_letters(), p_to_position->get_letters(),
+        [&](const coordinate &p_coord) {
+          const auto _candidate{
+              _vertically ? vertical_candidate(p_grid, p_coord, _layout,
+                                               p_to_position)
+                          : horizontal_candidate(p_grid, p_coord, _layout,
+                                                 p_to_position)};
+          if (_candidate) {
+            const placement _placement{
+                _candidate->first, _candidate->second,
+                _vertically ? orientation::vert : orientation::hori};
+            if (std::find(p_candidates.begin(), p_candidates.end(),
+                          _placement) == p_candidates.end()) {
+              p_candidates.push_back(_placement);
+            }
+          }
+          return false;
+        });
+  }
+}
+
+template <typename t_grid>
+bool two_first_words_intersect(std::atomic<bool> &p_stop,
+                               const t_grid &p_grid) {
+  using namespace typ;
+  typename t_grid::const_layout_ite _layout = p_grid.begin();
+  typename t_grid::const_layout_ite _to_position = std::next(p_grid.begin());
   if (_to_position == p_grid.end()) {
     return false;
   }
 
-  if ((_to_position == std::next(_layout)) &&
-      find_intersections(p_stop, _layout->get_word(), _to_position->get_word())
-          .empty()) {
+  bool _intersect{false};
+  for_each_intersection(p_stop, _layout->get_letters(),
+                        _to_position->get_letters(),
+                        [&_intersect](const coordinate &) {
+                          _intersect = true;
+                          return true;
+                        });
+  return _intersect;
+}
+
+} // namespace internal
+
+/// \brief Word ordering policy that positions the words in the order of the
+/// permutation of the grid
+struct permutation_order {
+  /// \brief Defines the order in which the words after the first one will be
+  /// positioned
+  template <typename t_grid>
+  void operator()(t_grid &p_grid,
+                  std::vector<typename t_grid::layout_ite> &p_order) const {
+    p_order.clear();
+    for (auto _layout = std::next(p_grid.begin()); _layout != p_grid.end();
+         ++_layout) {
+      p_order.push_back(_layout);
+    }
+  }
+};
+
+/// \brief Word ordering policy that positions the longest words first,
+/// keeping the order of the permutation for words with the same size
+struct longest_first {
+  template <typename t_grid>
+  void operator()(t_grid &p_grid,
+                  std::vector<typename t_grid::layout_ite> &p_order) const {
+    permutation_order{}(p_grid, p_order);
+    std::stable_sort(p_order.begin(), p_order.end(),
+                     [](typename t_grid::layout_ite p_l1,
+                        typename t_grid::layout_ite p_l2) {
+                       return p_l1->get_size() > p_l2->get_size();
+                     });
+  }
+};
+
+/// \brief Anchor selection policy that positions the first word in each cell,
+/// row by row, horizontally, and then vertically
+template <typename t_grid>
+using row_major_anchors = internal::basic_first_word_positioner<t_grid>;
+
+/// \brief Anchor selection policy that positions the first word in each cell,
+/// row by row, skipping the vertical places when the grid is square
+template <typename t_grid>
+using canonical_anchors = internal::basic_canonical_positioner<t_grid>;
+
+/// \brief Anchor selection policy like \p canonical_anchors, but trying the
+/// places closer to the center of the grid first
+template <typename t_grid>
+using center_out_anchors =
+    internal::basic_canonical_positioner<t_grid,
+                                         internal::anchor_order::center_out>;
+
+/// \brief Anchor selection policy like \p canonical_anchors, but trying the
+/// places in a random order, with a generator set by \p seed
+template <typename t_grid>
+using random_anchors =
+    internal::basic_canonical_positioner<t_grid,
+                                         internal::anchor_order::random>;
+
+/// \brief Candidate ordering policy that positions a word at the first place
+/// it fits, trying the positioned words in the order they were positioned,
+/// and their intersections letter by letter
+struct first_fit {
+  template <typename t_grid>
+  bool
+  operator()(std::atomic<bool> &p_stop, t_grid &p_grid,
+             const std::vector<typename t_grid::const_layout_ite> &p_positioned,
+             typename t_grid::layout_ite p_to_position) const {
+    for (typename t_grid::const_layout_ite _layout : p_positioned) {
+      if (p_stop) {
+        return false;
+      }
+      if (internal::position(p_stop, p_grid, _layout, p_to_position)) {
+        return true;
+      }
+    }
     return false;
   }
-  return true;
-}
+};
+
+/// \brief Candidate ordering policy that evaluates all the places where a
+/// word fits, crossing any positioned word, and chooses the one that crosses
+/// more letters already in the grid, so the grid is denser
+struct most_crossings {
+  template <typename t_grid>
+  bool
+  operator()(std::atomic<bool> &p_stop, t_grid &p_grid,
+             const std::vector<typename t_grid::const_layout_ite> &p_positioned,
+             typename t_grid::layout_ite p_to_position) const {
+    using namespace typ;
+
+    std::optional<coordinate> _best;
+    orientation _best_orientation{orientation::undef};
+    size_t _best_crossings{0};
+
+    for (typename t_grid::const_layout_ite _layout : p_positioned) {
+      const bool _vertically{_layout->get_orientation() == orientation::hori};
+      internal::for_each_intersection(
+          p_stop, _layout->get_letters(), p_to_position->get_letters(),
+          [&](const coordinate &p_coord) {
+            const auto _candidate{
+                _vertically ? internal::vertical_candidate(
+                                  p_grid, p_coord, _layout, p_to_position)
+                            : internal::horizontal_candidate(
+                                  p_grid, p_coord, _layout, p_to_position)};
+            if (_candidate) {
+              const size_t _crossings{
+                  crossings(p_grid, *_candidate, _vertically,
+                            p_to_position->get_size())};
+              if (!_best || (_crossings > _best_crossings)) {
+                _best = _candidate;
+                _best_crossings = _crossings;
+                _best_orientation =
+                    _vertically ? orientation::vert : orientation::hori;
+              }
+            }
+            return false;
+          });
+    }
+
+    if (p_stop || !_best) {
+      return false;
+    }
+    p_grid.set(p_to_position, _best->first, _best->second, _best_orientation);
+    return true;
+  }
+
+private:
+  template <typename t_grid>
+  static size_t crossings(const t_grid &p_grid,
+                          const typ::coordinate &p_start, bool p_vertically,
+                          typ::index p_size) {
+    const std::string_view _span{
+        p_vertically
+            ? p_grid.get_col(p_start.second).substr(p_start.first, p_size)
+            : p_grid.get_row(p_start.first).substr(p_start.second, p_size)};
+    return static_cast<size_t>(
+        std::count_if(_span.begin(), _span.end(), [](typ::letter p_letter) {
+          return p_letter != typ::max_char;
+        }));
+  }
+};
+
+/// \brief Pruning policy that only checks if the two first words intersect,
+/// before trying to organize the grid
+struct first_words_pruning {
+  /// \brief Informs if it is worth trying to organize the grid
+  template <typename t_grid>
+  bool viable(std::atomic<bool> &p_stop, const t_grid &p_grid) const {
+    return internal::two_first_words_intersect(p_stop, p_grid);
+  }
+
+  /// \brief Informs if it is worth to continue positioning the words, after
+  /// \p p_positioned was positioned
+  template <typename t_grid>
+  bool keep(const t_grid &, typename t_grid::const_layout_ite) const {
+    return true;
+  }
+};
+
+/// \brief Pruning policy that, besides \p first_words_pruning, refuses grids
+/// where a word does not have a letter in common with any other word, as it
+/// could never be positioned crossing another word
+struct isolated_word_pruning {
+  template <typename t_grid>
+  bool viable(std::atomic<bool> &p_stop, const t_grid &p_grid) const {
+    if (!first_words_pruning{}.viable(p_stop, p_grid)) {
+      return false;
+    }
+    for (auto _layout = p_grid.begin(); !p_stop && (_layout != p_grid.end());
+         ++_layout) {
+      bool _intersect{false};
+      for (auto _other = p_grid.begin();
+           !p_stop && !_intersect && (_other != p_grid.end()); ++_other) {
+        if (_other == _layout) {
+          continue;
+        }
+        internal::for_each_intersection(p_stop, _layout->get_letters(),
+                                        _other->get_letters(),
+                                        [&_intersect](const typ::coordinate &) {
+                                          _intersect = true;
+                                          return true;
+                                        });
+      }
+      if (!_intersect) {
+        return false;
+      }
+    }
+    return !p_stop;
+  }
+
+  template <typename t_grid>
+  bool keep(const t_grid &, typename t_grid::const_layout_ite) const {
+    return true;
+  }
+};
+
+/// \brief Cancellation polling policy that reads the stop flag every time
+struct always_poll {
+  inline bool operator()(const std::atomic<bool> &p_stop) { return p_stop; }
+};
+
+/// \brief Cancellation polling policy that reads the stop flag once every
+/// \p t_period times
+template <uint32_t t_period> struct periodic_poll {
+  static_assert(t_period > 0, "period must be greater than 0");
+
+  inline bool operator()(const std::atomic<bool> &p_stop) {
+    if (++m_count < t_period) {
+      return false;
+    }
+    m_count = 0;
+    return p_stop;
+  }
 
-struct organizer {
-  ~organizer() = default;
+private:
+  uint32_t m_count{0};
+};
+
+namespace internal {
 
-  bool operator()(std::shared_ptr<typ::grid> p_grid) {
+/// \brief Tries to position all the words of a grid
+///
+/// \details The strategy is defined by policies, so each combination is
+/// specialized at compile time
+///
+/// \tparam t_grid type of grid, like \p typ::grid or \p typ::fixed_grid
+///
+/// \tparam t_word_order defines the order in which the words after the first
+/// are positioned, like \p permutation_order or \p longest_first
+///
+/// \tparam t_anchors template, on the type of grid, of the positioner of the
+/// first word, like \p row_major_anchors
+///
+/// \tparam t_candidates chooses where a word is positioned, like
+/// \p first_fit or \p most_crossings
+///
+/// \tparam t_pruning refuses grids, or attempts, that can not be organized,
+/// like \p first_words_pruning or \p isolated_word_pruning
+///
+/// \tparam t_polling defines how often the stop flag is read, like
+/// \p always_poll or \p periodic_poll
+template <typename t_grid, typename t_word_order = permutation_order,
+          template <typename> typename t_anchors = row_major_anchors,
+          typename t_candidates = first_fit,
+          typename t_pruning = first_words_pruning,
+          typename t_polling = always_poll>
+struct basic_organizer {
+  ~basic_organizer() = default;
+
+  bool operator()(std::shared_ptr<t_grid> p_grid) {
     using namespace typ;
     if (m_stop) {
       TNCT_LOG_TRA("organizer ", this, ": stopped");
@@ -321,7 +817,7 @@ struct organizer {
       return false;
     }
 
-    if (!two_first_words_intersect(m_stop, *p_grid)) {
+    if (!m_pruning.viable(m_stop, *p_grid)) {
       TNCT_LOG_TRA("organizer ", this,
                    ": no organization possible because no word intersects '",
                    p_grid->begin()->get_word(), '\'');
@@ -336,28 +832,26 @@ struct organizer {
       TNCT_LOG_TRA("organizer ", this, ": stopped");
       return false;
     }
-    internal::first_word_positioner _first_word_positioner;
 
-    while (!m_stop && (_first_word_positioner(m_stop, *p_grid))) {
+    m_word_order(*p_grid, m_order);
+    m_positioned.reserve(m_order.size() + 1);
 
-      grid::const_layout_ite _end = p_grid->end();
-      grid::const_layout_ite _layout = p_grid->begin();
-      grid::layout_ite _to_position = std::next(p_grid->begin());
-      while (!m_stop && (_to_position != _end)) {
+    t_anchors<t_grid> _anchors;
 
-        while (!m_stop && (_layout->is_positioned()) && (_layout != _end)) {
-          if (internal::position(m_stop, *p_grid, _layout, _to_position)) {
-            break;
-          } else {
-            ++_layout;
-          }
+    while (!m_stop && _anchors(m_stop, *p_grid)) {
+      m_positioned.clear();
+      m_positioned.push_back(p_grid->begin());
+
+      for (typename t_grid::layout_ite _to_position : m_order) {
+        if (m_polling(m_stop)) {
+          break;
         }
-        if (!m_stop) {
-          if (!_to_position->is_positioned()) {
-            break;
-          }
-          _layout = p_grid->begin();
-          ++_to_position;
+        if (!m_candidates(m_stop, *p_grid, m_positioned, _to_position)) {
+          break;
+        }
+        m_positioned.push_back(_to_position);
+        if (!m_pruning.keep(*p_grid, _to_position)) {
+          break;
         }
       }
 
@@ -379,32 +873,689 @@ struct organizer {
   inline void stop() { m_stop = true; }
 
 private:
-  bool m_stop{false};
+  std::atomic<bool> m_stop{false};
+  t_word_order m_word_order;
+  t_candidates m_candidates;
+  t_pruning m_pruning;
+  t_polling m_polling;
+
+  /// \brief Order in which the words after the first are positioned
+  std::vector<typename t_grid::layout_ite> m_order;
+
+  /// \brief Words positioned in the current attempt, in the order they were
+  /// positioned
+  std::vector<typename t_grid::const_layout_ite> m_positioned;
 };
 
+using organizer = basic_organizer<typ::grid>;
+
 bool compare_entries(const typ::entry &p_e1, const typ::entry &p_e2) {
-  if (p_e1.get_word().size() == p_e2.get_word().size()) {
+  const typ::index _size1{typ::get_size(p_e1.get_word())};
+  const typ::index _size2{typ::get_size(p_e2.get_word())};
+  if (_size1 == _size2) {
     return p_e1.get_word() < p_e2.get_word();
   }
-  return p_e1.get_word().size() < p_e2.get_word().size();
+  return _size1 < _size2;
 }
 
 void sort_entries(typ::entries &p_entries) {
   std::sort(p_entries.begin(), p_entries.end(), compare_entries);
 }
 
+/// \brief Informs if an organizer can share a \p typ::nogood_store with the
+/// organizers of the other threads
+template <typename t_organizer, typename = void>
+struct shares_nogoods : std::false_type {};
+
+template <typename t_organizer>
+struct shares_nogoods<t_organizer,
+                      std::void_t<decltype(std::declval<t_organizer &>()
+                                               .set_nogoods(nullptr))>>
+    : std::true_type {};
+
+/// \brief Informs if an organizer can share a \p typ::transposition_table
+/// with the organizers of the other threads
+template <typename t_organizer, typename = void>
+struct shares_transpositions : std::false_type {};
+
+template <typename t_organizer>
+struct shares_transpositions<
+    t_organizer, std::void_t<decltype(std::declval<t_organizer &>()
+                                          .set_transpositions(nullptr))>>
+    : std::true_type {};
+
+/// \brief Informs if a policy, or an organizer, has a \p seed method to set
+/// its random generator
+template <typename t_policy, typename = void>
+struct has_seed : std::false_type {};
+
+template <typename t_policy>
+struct has_seed<t_policy, std::void_t<decltype(std::declval<t_policy &>().seed(
+                              uint64_t{0}))>> : std::true_type {};
+
+/// \brief Sets the seed of a policy, if it has a random generator
+template <typename t_policy> void seed(t_policy &p_policy, uint64_t p_seed) {
+  if constexpr (has_seed<t_policy>::value) {
+    p_policy.seed(p_seed);
+  }
+}
+
 } // namespace internal
 
+/// \brief Permutation policy of \p basic_assembler that generates the
+/// permutations in lexicographic order, starting with the longest words first
+struct lexicographic_permutations {
+  /// \brief Number of permutations of \p p_num_words, or the maximum
+  /// \p uint64_t if there are more
+  std::optional<uint64_t> count(size_t p_num_words) const {
+    auto _count{lib::math::alg::factorial<uint64_t>(p_num_words)};
+    return _count ? _count : std::numeric_limits<uint64_t>::max();
+  }
+
+  /// \param p_sorted words sorted by \p internal::compare_entries
+  void start(const typ::permutation &p_sorted) { m_sorted = p_sorted; }
+
+  /// \brief Next permutation to be organized
+  ///
+  /// \return \p false if all the permutations were generated
+  bool operator()(typ::permutation &p_permutation) {
+    p_permutation.resize(m_sorted.size());
+    std::reverse_copy(m_sorted.begin(), m_sorted.end(), p_permutation.begin());
+    std::next_permutation(m_sorted.begin(), m_sorted.end(),
+                          [](typ::entries::const_entry_ite p_e1,
+                             typ::entries::const_entry_ite p_e2) -> bool {
+                            return internal::compare_entries(*p_e1, *p_e2);
+                          });
+    return true;
+  }
+
+private:
+  typ::permutation m_sorted;
+};
+
+/// \brief Permutation policy of \p basic_assembler that generates the
+/// permutations in increasing number of discrepancies from the longest words
+/// first order
+///
+/// \details A permutation is built choosing, for each position, one of the
+/// words not yet chosen, in the longest first order, and choosing a word
+/// that is not the first is a discrepancy. When that order is close to an
+/// organization, the permutation needed is a few discrepancies away, while
+/// \p lexicographic_permutations only changes the first words after trying
+/// all the permutations of the others.
+///
+/// The permutations with \p d discrepancies are generated after all the ones
+/// with less than \p d, with the discrepancies at the first positions
+/// first, as the order of the longest words is the one that matters more.
+///
+/// \tparam t_max_discrepancy maximum number of discrepancies
+template <size_t t_max_discrepancy = 2> struct discrepancy_permutations {
+  /// \brief Number of permutations with up to \p t_max_discrepancy
+  /// discrepancies, or the maximum \p uint64_t if there are more
+  std::optional<uint64_t> count(size_t p_num_words) const {
+    // number of permutations with exactly \p d discrepancies, which is the
+    // elementary symmetric polynomial of degree \p d of the number of
+    // discrepancies possible at each position
+    std::vector<uint64_t> _exactly(t_max_discrepancy + 1, 0);
+    _exactly[0] = 1;
+    constexpr uint64_t _max{std::numeric_limits<uint64_t>::max()};
+    for (size_t _position = 0; _position + 1 < p_num_words; ++_position) {
+      const uint64_t _choices{p_num_words - 1 - _position};
+      for (size_t _d = t_max_discrepancy; _d > 0; --_d) {
+        const uint64_t _more{(_exactly[_d - 1] > _max / _choices)
+                                 ? _max
+                                 : _exactly[_d - 1] * _choices};
+        _exactly[_d] = (_exactly[_d] > _max - _more) ? _max
+                                                      : _exactly[_d] + _more;
+      }
+    }
+    uint64_t _count{0};
+    for (uint64_t _d : _exactly) {
+      _count = (_count > _max - _d) ? _max : _count + _d;
+    }
+    return _count;
+  }
+
+  /// \param p_sorted words sorted by \p internal::compare_entries
+  void start(const typ::permutation &p_sorted) {
+    m_longest_first.assign(p_sorted.rbegin(), p_sorted.rend());
+    m_discrepancy = 0;
+    m_positions.clear();
+    m_choices.assign(m_longest_first.size(), 0);
+    m_done = false;
+  }
+
+  /// \brief Next permutation to be organized
+  ///
+  /// \return \p false if all the permutations with up to
+  /// \p t_max_discrepancy discrepancies were generated
+  bool operator()(typ::permutation &p_permutation) {
+    if (m_done) {
+      return false;
+    }
+
+    m_remaining = m_longest_first;
+    p_permutation.clear();
+    for (size_t _choice : m_choices) {
+      p_permutation.push_back(m_remaining[_choice]);
+      m_remaining.erase(std::next(m_remaining.begin(), _choice));
+    }
+
+    m_done = !advance();
+    return true;
+  }
+
+  /// \brief Number of discrepancies of the permutation to be generated
+  inline size_t get_discrepancy() const { return m_discrepancy; }
+
+private:
+  /// \brief Number of discrepancies possible at a position
+  inline size_t choices(size_t p_position) const {
+    return m_longest_first.size() - 1 - p_position;
+  }
+
+  /// \brief Moves to the next permutation
+  ///
+  /// \return \p false if there are no more permutations
+  bool advance() {
+    // next choice at the positions of the discrepancies, the last position
+    // changing faster
+    for (size_t _i = m_positions.size(); _i > 0; --_i) {
+      const size_t _position{m_positions[_i - 1]};
+      if (m_choices[_position] < choices(_position)) {
+        ++m_choices[_position];
+        return true;
+      }
+      m_choices[_position] = 1;
+    }
+
+    // next combination of positions, or more discrepancies
+    if (!next_positions()) {
+      if (++m_discrepancy > t_max_discrepancy) {
+        return false;
+      }
+      m_positions.clear();
+      for (size_t _d = 0; _d < m_discrepancy; ++_d) {
+        m_positions.push_back(_d);
+      }
+      if (m_positions.empty() || (m_positions.back() + 1 >= m_choices.size())) {
+        // not enough positions for this number of discrepancies
+        return false;
+      }
+    }
+    std::fill(m_choices.begin(), m_choices.end(), 0);
+    for (size_t _position : m_positions) {
+      m_choices[_position] = 1;
+    }
+    return true;
+  }
+
+  /// \brief Next combination of \p m_discrepancy positions, out of the
+  /// positions that allow a discrepancy, i.e., all but the last
+  bool next_positions() {
+    const size_t _size{m_positions.size()};
+    const size_t _num_positions{m_choices.empty() ? 0 : m_choices.size() - 1};
+    for (size_t _i = _size; _i > 0; --_i) {
+      if (m_positions[_i - 1] < _num_positions - (_size - _i + 1)) {
+        ++m_positions[_i - 1];
+        for (size_t _j = _i; _j < _size; ++_j) {
+          m_positions[_j] = m_positions[_j - 1] + 1;
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  typ::permutation m_longest_first;
+  typ::permutation m_remaining;
+  size_t m_discrepancy{0};
+
+  /// \brief Positions of the discrepancies, in increasing order
+  std::vector<size_t> m_positions;
+
+  /// \brief Index of the word chosen at each position, among the words not
+  /// yet chosen, in the longest first order
+  std::vector<size_t> m_choices;
+
+  bool m_done{false};
+};
+
+/// \brief Permutation policy of \p basic_assembler that draws permutations
+/// uniformly at random, without repeating them
+///
+/// \details When the maximum number of tries is much smaller than the
+/// number of permutations, \p lexicographic_permutations only tries
+/// permutations that start with the same words, so a fixed number of tries
+/// covers the permutations far more evenly with this policy.
+///
+/// The draw \p i is the permutation whose rank is the image of \p i by a
+/// bijection of the ranks, a Feistel network keyed by the seed, with cycle
+/// walking so the image is less than the number of permutations. The rank
+/// is then written in the mixed radix \p n, \p n - 1, ..., 1, each digit
+/// choosing one of the words not yet chosen, starting with the first
+/// position. So any draw can be computed independently, with \p at, and
+/// workers can share the draws, each one taking every \p k-th.
+///
+/// With more than 20 words, the number of permutations does not fit in 64
+/// bits, so the ranks are the 64 bits numbers, which still choose the first
+/// words uniformly, and only the last ones are less random.
+struct random_permutations {
+  random_permutations(uint64_t p_seed = 0) { seed(p_seed); }
+
+  /// \brief Sets the seed, which defines the order of the draws
+  void seed(uint64_t p_seed) {
+    for (size_t _round = 0; _round < num_rounds; ++_round) {
+      m_keys[_round] = typ::mix(p_seed + _round);
+    }
+  }
+
+  /// \brief Number of permutations of \p p_num_words, or the maximum
+  /// \p uint64_t if there are more
+  std::optional<uint64_t> count(size_t p_num_words) const {
+    auto _count{lib::math::alg::factorial<uint64_t>(p_num_words)};
+    return _count ? _count : std::numeric_limits<uint64_t>::max();
+  }
+
+  /// \param p_sorted words sorted by \p internal::compare_entries
+  void start(const typ::permutation &p_sorted) {
+    m_words.assign(p_sorted.rbegin(), p_sorted.rend());
+    m_next = 0;
+    auto _count{lib::math::alg::factorial<uint64_t>(m_words.size())};
+    // 0 means all the 64 bits numbers
+    m_size = _count ? _count.value() : 0;
+    m_half_bits = 32;
+    if (m_size != 0) {
+      size_t _bits{1};
+      while ((_bits < 64) && ((uint64_t{1} << _bits) < m_size)) {
+        ++_bits;
+      }
+      m_half_bits = (_bits + 1) / 2;
+    }
+  }
+
+  /// \brief Next permutation to be organized
+  ///
+  /// \return \p false if all the permutations were drawn
+  bool operator()(typ::permutation &p_permutation) {
+    if ((m_size != 0) && (m_next == m_size)) {
+      return false;
+    }
+    at(m_next++, p_permutation);
+    return true;
+  }
+
+  /// \brief Permutation of the draw \p p_draw
+  void at(uint64_t p_draw, typ::permutation &p_permutation) const {
+    uint64_t _rank{feistel(p_draw)};
+    while ((m_size != 0) && (_rank >= m_size)) {
+      _rank = feistel(_rank);
+    }
+
+    p_permutation = m_words;
+    for (size_t _position = 0; _position + 1 < p_permutation.size();
+         ++_position) {
+      const uint64_t _radix{p_permutation.size() - _position};
+      const size_t _choice{static_cast<size_t>(_rank % _radix)};
+      _rank /= _radix;
+      std::swap(p_permutation[_position],
+                p_permutation[_position + _choice]);
+    }
+  }
+
+private:
+  static constexpr size_t num_rounds{4};
+
+  /// \brief Bijection of the numbers with \p 2 * m_half_bits bits
+  uint64_t feistel(uint64_t p_value) const {
+    const uint64_t _mask{(m_half_bits == 32)
+                             ? uint64_t{0xFFFFFFFF}
+                             : ((uint64_t{1} << m_half_bits) - 1)};
+    uint64_t _left{(p_value >> m_half_bits) & _mask};
+    uint64_t _right{p_value & _mask};
+    for (size_t _round = 0; _round < num_rounds; ++_round) {
+      const uint64_t _aux{_left ^ (typ::mix(_right ^ m_keys[_round]) & _mask)};
+      _left = _right;
+      _right = _aux;
+    }
+    return (_left << m_half_bits) | _right;
+  }
+
+private:
+  std::array<uint64_t, num_rounds> m_keys;
+  typ::permutation m_words;
+  uint64_t m_next{0};
+  uint64_t m_size{0};
+  size_t m_half_bits{32};
+};
+
+/// \brief Permutation policy of \p basic_assembler that generates the
+/// permutations in decreasing order of an estimate of their chance of being
+/// organized
+///
+/// \details The estimate of a permutation is the sum, for each position, of:
+/// \p crossing_weight times the number of letters the word shares with the
+/// previous one, relative to the maximum among all the pairs of words;
+/// \p degree_weight times the degree of the word in the intersection graph,
+/// relative to the maximum, and \p length_weight times its size, relative to
+/// the longest word, both decreasing linearly with the position, so words
+/// that cross many others, and long words, are preferred at the beginning;
+/// and a penalty of \p n, the number of words, when the word does not share
+/// a letter with any of the words before it, as it could not be positioned.
+///
+/// The permutations are not all generated. A node of a priority queue is a
+/// prefix, some words excluded from the position after it, and the greedy
+/// completion of the prefix, i.e., the permutation that appends, at each
+/// position, the word with the highest estimate. The node with the highest
+/// estimate, less \p diversity_weight for each word of the prefix, is
+/// popped, its completion is returned, and the permutations
+/// of the node that were not returned are partitioned in up to \p n - 1
+/// nodes: the completion with its first \p j words, excluding the next word
+/// of the completion from the position \p j. So no permutation is returned
+/// twice, and all of them are eventually returned.
+///
+/// Each permutation returned adds up to \p n - 1 nodes to the queue, each
+/// one computed in \p O(n^2), so the memory grows with the number of tries.
+struct best_first_permutations {
+  static constexpr double crossing_weight{1.0};
+  static constexpr double degree_weight{1.0};
+  static constexpr double length_weight{1.0};
+  static constexpr double diversity_weight{1.0};
+
+  /// \brief Number of permutations of \p p_num_words, or the maximum
+  /// \p uint64_t if there are more
+  std::optional<uint64_t> count(size_t p_num_words) const {
+    auto _count{lib::math::alg::factorial<uint64_t>(p_num_words)};
+    return _count ? _count : std::numeric_limits<uint64_t>::max();
+  }
+
+  /// \param p_sorted words sorted by \p internal::compare_entries
+  void start(const typ::permutation &p_sorted) {
+    m_words.assign(p_sorted.rbegin(), p_sorted.rend());
+    const size_t _size{m_words.size()};
+
+    // the words are compared letter by letter, not byte by byte, as a
+    // letter can have more than one byte in UTF-8
+    std::vector<std::u32string> _letters;
+    _letters.reserve(_size);
+    for (typ::entries::const_entry_ite _word : m_words) {
+      _letters.push_back(typ::decode_utf8(_word->get_word()));
+    }
+
+    m_crossings.assign(_size * _size, 0);
+    m_degrees.assign(_size, 0);
+    m_max_crossings = 1;
+    size_t _max_degree{1};
+    for (size_t _i = 0; _i < _size; ++_i) {
+      for (size_t _j = _i + 1; _j < _size; ++_j) {
+        size_t _crossings{0};
+        for (char32_t _letter_i : _letters[_i]) {
+          _crossings += static_cast<size_t>(std::count(
+              _letters[_j].begin(), _letters[_j].end(), _letter_i));
+        }
+        m_crossings[_i * _size + _j] = _crossings;
+        m_crossings[_j * _size + _i] = _crossings;
+        m_max_crossings = std::max(m_max_crossings, _crossings);
+        if (_crossings != 0) {
+          ++m_degrees[_i];
+          ++m_degrees[_j];
+        }
+      }
+      _max_degree = std::max(_max_degree, m_degrees[_i]);
+    }
+
+    m_degree_estimates.assign(_size, 0.0);
+    m_length_estimates.assign(_size, 0.0);
+    size_t _longest{1};
+    for (const std::u32string &_word : _letters) {
+      _longest = std::max(_longest, _word.size());
+    }
+    for (size_t _i = 0; _i < _size; ++_i) {
+      m_degree_estimates[_i] = degree_weight *
+                               static_cast<double>(m_degrees[_i]) /
+                               static_cast<double>(_max_degree);
+      m_length_estimates[_i] = length_weight *
+                               static_cast<double>(_letters[_i].size()) /
+                               static_cast<double>(_longest);
+    }
+
+    m_queue = queue{};
+    m_num_nodes = 0;
+    node _root;
+    if (complete(_root)) {
+      push(std::move(_root));
+    }
+  }
+
+  /// \brief Next permutation to be organized
+  ///
+  /// \return \p false if all the permutations were generated
+  bool operator()(typ::permutation &p_permutation) {
+    if (m_queue.empty()) {
+      return false;
+    }
+    node _node{m_queue.top()};
+    m_queue.pop();
+
+    p_permutation.clear();
+    for (word_index _word : _node.order) {
+      p_permutation.push_back(m_words[_word]);
+    }
+
+    // the other permutations of the node: the ones that share the first
+    // _fixed words of the completion, and not the next one
+    const size_t _size{_node.order.size()};
+    for (size_t _fixed = _node.fixed; _fixed + 1 < _size; ++_fixed) {
+      node _child;
+      _child.order.assign(_node.order.begin(),
+                          std::next(_node.order.begin(), _fixed));
+      _child.fixed = _fixed;
+      if (_fixed == _node.fixed) {
+        _child.excluded = _node.excluded;
+      }
+      _child.excluded.push_back(_node.order[_fixed]);
+      if (complete(_child)) {
+        push(std::move(_child));
+      }
+    }
+    return true;
+  }
+
+  /// \brief Estimate of the chance of \p p_permutation being organized, as
+  /// used to order the permutations, for permutations of the words passed to
+  /// \p start
+  double estimate(const typ::permutation &p_permutation) const {
+    std::vector<bool> _used(m_words.size(), false);
+    double _estimate{0.0};
+    size_t _previous{0};
+    for (size_t _position = 0; _position < p_permutation.size(); ++_position) {
+      const size_t _word{static_cast<size_t>(
+          std::distance(m_words.begin(),
+                        std::find(m_words.begin(), m_words.end(),
+                                  p_permutation[_position])))};
+      _estimate += gain(_position, _word, _previous, _used);
+      _used[_word] = true;
+      _previous = _word;
+    }
+    return _estimate;
+  }
+
+  /// \brief Number of nodes waiting in the priority queue
+  inline size_t get_num_nodes() const { return m_queue.size(); }
+
+private:
+  /// \brief Position of a word in \p m_words, as wide as the number of
+  /// entries
+  using word_index = typ::entries::size;
+
+  struct node {
+    /// \brief Prefix, followed by its greedy completion
+    std::vector<word_index> order;
+
+    /// \brief Size of the prefix
+    size_t fixed{0};
+
+    /// \brief Words that can not be at the position \p fixed
+    std::vector<word_index> excluded;
+
+    double estimate{0.0};
+
+    /// \brief Order of creation, so nodes with the same estimate are popped
+    /// in the order they were created
+    uint64_t sequence{0};
+  };
+
+  struct worse {
+    bool operator()(const node &p_n1, const node &p_n2) const {
+      const double _priority1{priority(p_n1)};
+      const double _priority2{priority(p_n2)};
+      if (_priority1 != _priority2) {
+        return _priority1 < _priority2;
+      }
+      return p_n1.sequence > p_n2.sequence;
+    }
+  };
+
+  using queue = std::priority_queue<node, std::vector<node>, worse>;
+
+  /// \brief The estimate of the completion of \p p_node, less
+  /// \p diversity_weight for each word of its prefix
+  ///
+  /// \details The organizer positions the words in the order of the
+  /// permutation, so permutations that differ only after the first word that
+  /// could not be positioned fail the same way, and changing the first words
+  /// is preferred
+  static double priority(const node &p_node) {
+    return p_node.estimate -
+           diversity_weight * static_cast<double>(p_node.fixed);
+  }
+
+private:
+  /// \brief Estimate of positioning \p p_word at \p p_position, after
+  /// \p p_previous, when the words in \p p_used are before it
+  double gain(size_t p_position, size_t p_word, size_t p_previous,
+              const std::vector<bool> &p_used) const {
+    const size_t _size{m_words.size()};
+    const double _earliness{static_cast<double>(_size - p_position) /
+                            static_cast<double>(_size)};
+    double _gain{(m_degree_estimates[p_word] + m_length_estimates[p_word]) *
+                 _earliness};
+    if (p_position == 0) {
+      return _gain;
+    }
+
+    _gain += crossing_weight *
+             static_cast<double>(m_crossings[p_previous * _size + p_word]) /
+             static_cast<double>(m_max_crossings);
+
+    bool _crosses{false};
+    for (size_t _other = 0; !_crosses && (_other < _size); ++_other) {
+      _crosses = p_used[_other] && (m_crossings[_other * _size + p_word] != 0);
+    }
+    if (!_crosses) {
+      _gain -= static_cast<double>(_size);
+    }
+    return _gain;
+  }
+
+  /// \brief Appends to the prefix of \p p_node the words with the highest
+  /// estimate, and computes the estimate of the permutation
+  ///
+  /// \return \p false if all the words were excluded from the position after
+  /// the prefix
+  bool complete(node &p_node) const {
+    const size_t _size{m_words.size()};
+    std::vector<bool> _used(_size, false);
+    p_node.estimate = 0.0;
+    size_t _previous{0};
+    for (size_t _position = 0; _position < p_node.fixed; ++_position) {
+      const size_t _word{p_node.order[_position]};
+      p_node.estimate += gain(_position, _word, _previous, _used);
+      _used[_word] = true;
+      _previous = _word;
+    }
+
+    for (size_t _position = p_node.fixed; _position < _size; ++_position) {
+      size_t _best{_size};
+      double _best_gain{0.0};
+      for (size_t _word = 0; _word < _size; ++_word) {
+        if (_used[_word]) {
+          continue;
+        }
+        if ((_position == p_node.fixed) &&
+            (std::find(p_node.excluded.begin(), p_node.excluded.end(),
+                       _word) != p_node.excluded.end())) {
+          continue;
+        }
+        const double _gain{gain(_position, _word, _previous, _used)};
+        if ((_best == _size) || (_gain > _best_gain)) {
+          _best = _word;
+          _best_gain = _gain;
+        }
+      }
+      if (_best == _size) {
+        return false;
+      }
+      p_node.order.push_back(static_cast<word_index>(_best));
+      p_node.estimate += _best_gain;
+      _used[_best] = true;
+      _previous = _best;
+    }
+    return true;
+  }
+
+  void push(node &&p_node) {
+    p_node.sequence = m_num_nodes++;
+    m_queue.push(std::move(p_node));
+  }
+
+private:
+  /// \brief Words in the longest first order, indexed by the nodes
+  typ::permutation m_words;
+
+  /// \brief Number of letters shared by each pair of words
+  std::vector<size_t> m_crossings;
+  size_t m_max_crossings{1};
+
+  /// \brief Number of words that share a letter with each word
+  std::vector<size_t> m_degrees;
+
+  std::vector<double> m_degree_estimates;
+  std::vector<double> m_length_estimates;
+
+  queue m_queue;
+  uint64_t m_num_nodes{0};
+};
+
 /// \brief Tries to assemble a grid
-struct assembler {
-  assembler(lib::async::alg::dispatcher::ptr p_dispatcher)
+///
+/// \tparam t_grid type of grid, like \p typ::grid, or \p typ::fixed_grid
+/// when the dimensions are known at compile time
+///
+/// \tparam t_organizer type of organizer, that defines the strategy used to
+/// position the words, like \p internal::basic_organizer with its policies
+///
+/// \tparam t_permutations order in which the permutations of the words are
+/// tried, like \p lexicographic_permutations,
+/// \p discrepancy_permutations, \p random_permutations or
+/// \p best_first_permutations; the permutations are distributed among the
+/// organizers of all the threads in that order
+template <typename t_grid,
+          typename t_organizer = internal::basic_organizer<t_grid>,
+          typename t_permutations = lexicographic_permutations>
+struct basic_assembler {
+  using new_grid_to_organize = evt::basic_new_grid_to_organize<t_grid>;
+  using assembly_finished = evt::basic_assembly_finished<t_grid>;
+
+  basic_assembler(lib::async::alg::dispatcher::ptr p_dispatcher)
       : m_dispatcher(p_dispatcher) {}
-  assembler() = delete;
-  assembler(const assembler &) = delete;
-  assembler(assembler &&) = delete;
-  assembler &operator=(const assembler &) = delete;
-  assembler &operator=(assembler &&) = delete;
-  ~assembler() = default;
+  basic_assembler() = delete;
+  basic_assembler(const basic_assembler &) = delete;
+  basic_assembler(basic_assembler &&) = delete;
+  basic_assembler &operator=(const basic_assembler &) = delete;
+  basic_assembler &operator=(basic_assembler &&) = delete;
+  ~basic_assembler() = default;
 
   /// \brief Tries to assemble a tenacitas::crosswords::typ::grid
   ///
@@ -421,6 +1572,9 @@ struct assembler {
   ///
   /// \param p_max_tries maximum number of attempts to assemble the grid
   ///
+  /// \param p_memory maximum number of bytes of the \p typ::transposition_table
+  /// shared by the organizers, if they use one
+  ///
   /// \details The problem grows exponencially with the number of words. For
   /// instance, with 10 words, there 10! (factorial of 10), i.e. 3628800,
   /// possible combination, and, maybe, with one of them a grid can be
@@ -430,12 +1584,14 @@ struct assembler {
   /// used.
   /// However, as the number of combinations can be huge, it is possible to
   /// define the maximum number of attempts for assembling, before giving it up.
-  std::shared_ptr<typ::grid>
+  std::shared_ptr<t_grid>
   start(const typ::entries &p_entries, typ::index p_num_rows,
-        typ::index p_num_cols, uint8_t p_num_threads = 20,
-        uint64_t p_max_tries = std::numeric_limits<uint64_t>::max()) {
+        typ::index p_num_cols, size_t p_num_threads = 20,
+        uint64_t p_max_tries = std::numeric_limits<uint64_t>::max(),
+        size_t p_memory = typ::transposition_table::default_memory) {
 
     m_num_threads = p_num_threads;
+    m_memory = p_memory;
 
     m_entries = p_entries;
 
@@ -444,14 +1600,23 @@ struct assembler {
     typ::entries _entries{m_entries};
     internal::sort_entries(_entries);
 
+    std::shared_ptr<typ::alphabet> _alphabet{std::make_shared<typ::alphabet>()};
+    try {
+      for (const typ::entry &_entry : _entries) {
+        _alphabet->add(_entry.get_word());
+      }
+    } catch (std::exception &_ex) {
+      TNCT_LOG_ERR(_ex.what());
+      return nullptr;
+    }
+
     typ::permutation _permutation;
     for (typ::entries::const_entry_ite _entry = _entries.begin();
          _entry != _entries.end(); ++_entry) {
       _permutation.push_back(_entry);
     }
 
-    auto _maybe{
-        lib::math::alg::factorial<uint64_t>(_entries.get_num_entries())};
+    auto _maybe{m_permutations.count(_entries.get_num_entries())};
 
     uint64_t _max_permutations{0};
 
@@ -467,6 +1632,7 @@ struct assembler {
 
     TNCT_LOG_TRA("_max_permutation_number = ", _max_permutations);
     m_permutation_counter = 0;
+    m_permutations.start(_permutation);
 
     while (true) {
       if (m_stop) {
@@ -479,45 +1645,47 @@ struct assembler {
         break;
       }
 
-      if (m_solved) {
+      if (solved()) {
         TNCT_LOG_TRA("stopping");
         break;
       }
 
-      typ::permutation _aux{_permutation.size()};
-      std::reverse_copy(_permutation.begin(), _permutation.end(), _aux.begin());
+      typ::permutation _aux;
+      if (!m_permutations(_aux)) {
+        TNCT_LOG_TRA("all the permutations generated");
+        break;
+      }
       TNCT_LOG_TRA(lib::number::alg::format(++m_permutation_counter), ": ",
                    _aux);
       m_dispatcher->publish<evt::new_attempt>(m_permutation_counter);
 
-      auto _grid{std::make_shared<typ::grid>(_aux, p_num_rows, p_num_cols,
-                                             m_permutation_counter)};
-      if (!m_dispatcher->publish<evt::new_grid_to_organize>(_grid)) {
+      auto _grid{std::make_shared<t_grid>(_aux, _alphabet, p_num_rows,
+                                          p_num_cols, m_permutation_counter)};
+      if (!m_dispatcher->publish<new_grid_to_organize>(_grid)) {
         TNCT_LOG_ERR("error publishing event evt::new_grid_to_organize");
       }
-
-      std::next_permutation(_permutation.begin(), _permutation.end(),
-                            [](typ::entries::const_entry_ite p_e1,
-                               typ::entries::const_entry_ite p_e2) -> bool {
-                              return internal::compare_entries(*p_e1, *p_e2);
-                            });
     }
     TNCT_LOG_TRA("left permutation loop, with ", m_permutation_counter,
-                 " permutations were generated, and m_stop = ", m_stop);
+                 " permutations were generated, and m_stop = ", m_stop.load());
 
     if (m_stop) {
       TNCT_LOG_TRA("stop requested");
+      stop_organizers();
       m_dispatcher->stop();
       return {};
     }
 
+    std::unique_lock<std::mutex> _lock(m_mutex_num_organizations_finished);
     if (!m_solved && (m_num_organizations_finished != m_permutation_counter)) {
       TNCT_LOG_TRA(
           "m_solved = ", m_solved,
           " and m_num_organizations_finished = ", m_num_organizations_finished);
-      std::unique_lock<std::mutex> _lock(m_mutex_num_organizations_finished);
       m_cond_num_organizations_finished.wait(_lock, [this]() -> bool {
         TNCT_LOG_TRA("entering lock");
+        if (m_stop) {
+          TNCT_LOG_TRA("lock released because stop was requested");
+          return true;
+        }
         if (m_num_organizations_finished == m_permutation_counter) {
           TNCT_LOG_TRA("lock released because all organizers have finished");
           return true;
@@ -528,50 +1696,113 @@ struct assembler {
         return false;
       });
     }
+    _lock.unlock();
+
+    if (m_stop) {
+      TNCT_LOG_TRA("stop requested while the organizers were running");
+      stop_organizers();
+    }
 
     m_dispatcher->stop();
 
-    if (m_solved) {
+    _lock.lock();
+    const std::shared_ptr<t_grid> _solved{m_solved};
+    const size_t _num_organizations_finished{m_num_organizations_finished};
+    _lock.unlock();
+
+    if (_solved) {
       TNCT_LOG_TRA(
           "one organizer organized the grid before all permutations were "
           "tried: ",
-          *m_solved);
-      return m_solved;
+          *_solved);
+      return _solved;
     }
 
-    if (m_num_organizations_finished == m_permutation_counter) {
+    if (_num_organizations_finished == m_permutation_counter) {
       TNCT_LOG_TRA(
-          "m_num_organizations_finished == ", m_num_organizations_finished,
+          "m_num_organizations_finished == ", _num_organizations_finished,
           " and no organizer organized the grid");
     }
     return {};
   }
 
   /// \brief Stops assembling the grid
-  inline void stop() { m_stop = true; }
+  ///
+  /// \details It can be called from another thread while \p start runs: the
+  /// organizers are told to stop, so the grids still queued are dropped, and
+  /// \p start stops waiting for them and returns
+  void stop() {
+    m_stop = true;
+    m_dispatcher->publish<evt::stop_organizing>();
+    std::lock_guard<std::mutex> _lock{m_mutex_num_organizations_finished};
+    m_cond_num_organizations_finished.notify_all();
+  }
 
   /// \brief Retrieves how many attempts were made
   uint64_t get_num_attempts() const { return m_permutation_counter; }
 
+  /// \brief Permutation policy, for its configuration, like a seed
+  inline t_permutations &get_permutations() { return m_permutations; }
+
 private:
-  using organizers = std::vector<bus::internal::organizer>;
+  using organizers = std::vector<t_organizer>;
 
 private:
+  /// \brief Grid organized, or \p nullptr
+  std::shared_ptr<t_grid> solved() {
+    std::lock_guard<std::mutex> _lock{m_mutex_num_organizations_finished};
+    return m_solved;
+  }
+
+  /// \brief Stops the organizers directly, in case the
+  /// \p evt::stop_organizing published by \p stop was not handled before
+  /// the dispatcher stops
+  void stop_organizers() {
+    for (t_organizer &_organizer : m_organizers) {
+      _organizer.stop();
+    }
+  }
+
   void configure_dispatcher() {
 
     TNCT_LOG_TRA("configuring publishing for event evt::stop_organizing");
     m_organizers = organizers(m_num_threads);
-    for (internal::organizer &_organizer : m_organizers) {
+    for (t_organizer &_organizer : m_organizers) {
       m_dispatcher->subscribe<evt::stop_organizing>(
           [&_organizer](auto) -> void { _organizer.stop(); });
     }
 
+    if constexpr (internal::has_seed<t_organizer>::value) {
+      TNCT_LOG_TRA("each organizer will have its own seed");
+      for (size_t _i = 0; _i < m_organizers.size(); ++_i) {
+        m_organizers[_i].seed(typ::mix(_i));
+      }
+    }
+
+    if constexpr (internal::shares_nogoods<t_organizer>::value) {
+      TNCT_LOG_TRA("organizers will share nogoods");
+      auto _nogoods{std::make_shared<typ::nogood_store>()};
+      for (t_organizer &_organizer : m_organizers) {
+        _organizer.set_nogoods(_nogoods);
+      }
+    }
+
+    if constexpr (internal::shares_transpositions<t_organizer>::value) {
+      TNCT_LOG_TRA("organizers will share a transposition table of ", m_memory,
+                   " bytes");
+      auto _transpositions{
+          std::make_shared<typ::transposition_table>(m_memory)};
+      for (t_organizer &_organizer : m_organizers) {
+        _organizer.set_transpositions(_transpositions);
+      }
+    }
+
     TNCT_LOG_TRA("configuring publishing for event evt::new_grid_to_organize");
     auto _new_grid_to_organize_publishing =
-        m_dispatcher->add_queue<evt::new_grid_to_organize>();
+        m_dispatcher->add_queue<new_grid_to_organize>();
 
     for (decltype(m_num_threads) _i = 0; _i < m_num_threads; ++_i) {
-      m_dispatcher->subscribe<evt::new_grid_to_organize>(
+      m_dispatcher->subscribe<new_grid_to_organize>(
           _new_grid_to_organize_publishing, [this, _i](auto p_event) -> void {
             if (p_event.grid == nullptr) {
               TNCT_LOG_ERR(
@@ -579,7 +1810,7 @@ private:
               return;
             }
 
-            internal::organizer &_organizer{m_organizers[_i]};
+            t_organizer &_organizer{m_organizers[_i]};
             TNCT_LOG_TRA("calling organizer ", &_organizer);
             if (_organizer(p_event.grid)) {
               TNCT_LOG_TRA("organizer ", &_organizer,
@@ -587,7 +1818,7 @@ private:
                            p_event.grid->get_permutation_number(),
                            "; notifying the grid is organized and notifying "
                            "other organizers to stop");
-              if (!m_dispatcher->publish<evt::assembly_finished>(
+              if (!m_dispatcher->publish<assembly_finished>(
                       p_event.grid)) {
                 TNCT_LOG_ERR("error publishing event evt::assembly_finished");
               }
@@ -598,14 +1829,15 @@ private:
               TNCT_LOG_TRA("organizer ", &_organizer,
                            " did not organize permutation ",
                            p_event.grid->get_permutation_number());
-              m_dispatcher->publish<evt::assembly_finished>(nullptr);
+              m_dispatcher->publish<assembly_finished>(nullptr);
             }
           });
     }
 
     TNCT_LOG_TRA("configuring publishing for event evt::assembly_finished");
-    m_dispatcher->subscribe<evt::assembly_finished>(
+    m_dispatcher->subscribe<assembly_finished>(
         [this](auto p_event) -> void {
+          std::lock_guard<std::mutex> _lock{m_mutex_num_organizations_finished};
           ++m_num_organizations_finished;
           TNCT_LOG_TRA(m_num_organizations_finished, " organizations finished");
           if (p_event.grid) {
@@ -617,19 +1849,23 @@ private:
               TNCT_LOG_TRA("but the final grid was already set");
             }
           }
-          std::lock_guard<std::mutex> _lock{m_mutex_num_organizations_finished};
           m_cond_num_organizations_finished.notify_all();
         });
   }
 
 private:
-  uint8_t m_num_threads = 20;
+  size_t m_num_threads = 20;
+  size_t m_memory{typ::transposition_table::default_memory};
   async::alg::dispatcher::ptr m_dispatcher;
   typ::entries m_entries;
-  bool m_stop{false};
+  std::atomic<bool> m_stop{false};
   uint64_t m_permutation_counter{0};
   organizers m_organizers;
-  std::shared_ptr<typ::grid> m_solved;
+  t_permutations m_permutations;
+  /// \brief Grid organized, set by the thread that handles
+  /// \p assembly_finished, so it is read and written only with
+  /// \p m_mutex_num_organizations_finished locked
+  std::shared_ptr<t_grid> m_solved;
   std::mutex m_mutex_organizers;
   std::condition_variable m_cond_stop;
   std::mutex m_mutex_stop;
@@ -638,6 +1874,9 @@ private:
   std::condition_variable m_cond_num_organizations_finished;
 };
 
+/// \brief Tries to assemble a grid with dimensions defined at run time
+using assembler = basic_assembler<typ::grid>;
+
 } // namespace tenacitas::lib::crosswords::bus
 
 #endif // ORGANIZER_H
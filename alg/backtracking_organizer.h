@@ -0,0 +1,1296 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_ALG_BACKTRACKING_ORGANIZER_H
+#define TENACITAS_LIB_CROSSWORDS_ALG_BACKTRACKING_ORGANIZER_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <tenacitas.lib.crosswords/alg/assembler.h>
+#include <tenacitas.lib.crosswords/typ/grid.h>
+#include <tenacitas.lib.crosswords/typ/nogood_store.h>
+#include <tenacitas.lib.crosswords/typ/transposition_table.h>
+#include <tenacitas.lib.log/alg/logger.h>
+
+namespace tenacitas::lib::crosswords::bus {
+
+namespace internal {
+
+/// \brief Keeps, for each word not positioned, the number of places where it
+/// can still be positioned, i.e., where every cell is free or has the same
+/// letter
+///
+/// \details A place, or slot, is a row, a column and an orientation. When a
+/// word is positioned, only the slots of the other words that cover the cells
+/// it filled are checked, and the ones that became illegal are recorded in a
+/// trail, so \p undo restores them without recomputing anything.
+///
+/// If a slot is legal is kept in one bit for each word and slot, i.e., the
+/// number of words times 2 times the number of cells of the grid, so it is
+/// meant for dense grids, and not for a \p typ::sparse_grid with millions of
+/// cells.
+///
+/// \tparam t_grid type of grid, like \p typ::grid or \p typ::fixed_grid
+template <typename t_grid> struct basic_forward_checker {
+  using layout_ite = typename t_grid::layout_ite;
+  using const_layout_ite = typename t_grid::const_layout_ite;
+
+  /// \brief Value of \p get_wiped_out when all the words have places left
+  static constexpr size_t no_word{std::numeric_limits<size_t>::max()};
+
+  /// \brief Considers all the slots inside \p p_grid legal for all its words
+  void start(const t_grid &p_grid) {
+    m_num_rows = p_grid.get_num_rows();
+    m_num_cols = p_grid.get_num_cols();
+    m_num_slots = 2 * static_cast<size_t>(m_num_rows) * m_num_cols;
+    m_begin = p_grid.begin();
+    m_num_words = static_cast<size_t>(std::distance(p_grid.begin(), p_grid.end()));
+
+    m_legal.assign(m_num_words * m_num_slots, false);
+    m_marked.assign(m_legal.size(), false);
+    m_counts.assign(m_num_words, 0);
+    m_positioned.assign(m_num_words, false);
+    m_trail.clear();
+    m_marks.clear();
+    m_wiped_out = no_word;
+
+    for (size_t _word = 0; _word < m_num_words; ++_word) {
+      const typ::index _size{std::next(m_begin, _word)->get_size()};
+      for (typ::index _row = 0; _row < m_num_rows; ++_row) {
+        for (typ::index _col = 0; _col < m_num_cols; ++_col) {
+          if (_col + _size <= m_num_cols) {
+            m_legal[pos(_word, hori_slot(_row, _col))] = true;
+            ++m_counts[_word];
+          }
+          if (_row + _size <= m_num_rows) {
+            m_legal[pos(_word, vert_slot(_row, _col))] = true;
+            ++m_counts[_word];
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Informs that \p p_layout was positioned in a grid where there was
+  /// no other word, like the first word positioned by an anchor policy
+  ///
+  /// \return \p false if a word not positioned has no place left
+  bool anchor(layout_ite p_layout) {
+    m_filled.clear();
+    for_each_cell(p_layout->get_row(), p_layout->get_col(),
+                  p_layout->get_orientation(), p_layout->get_size(),
+                  [&](typ::index p_row, typ::index p_col, typ::index p_i) {
+                    m_filled.push_back(
+                        {p_row, p_col, p_layout->get_letters()[p_i]});
+                  });
+    return update(p_layout);
+  }
+
+  /// \brief Positions a word, and removes the slots of the other words that
+  /// are not legal anymore, because of the cells it filled
+  ///
+  /// \return \p false if a word not positioned has no place left; the word is
+  /// positioned anyway, and \p undo must be called
+  bool place(t_grid &p_grid, layout_ite p_layout,
+             const placement &p_placement) {
+    collect_filled(p_grid, p_layout, p_placement);
+    p_grid.set(p_layout, p_placement.row, p_placement.col,
+               p_placement.orientation);
+    return update(p_layout);
+  }
+
+  /// \brief Removes the last word positioned with \p place or \p anchor, and
+  /// restores the slots it made illegal
+  void undo(t_grid &p_grid) {
+    const mark _mark{m_marks.back()};
+    m_marks.pop_back();
+    while (m_trail.size() > _mark.trail_size) {
+      const trail_entry &_entry{m_trail.back()};
+      m_legal[pos(_entry.word, _entry.slot)] = true;
+      ++m_counts[_entry.word];
+      m_trail.pop_back();
+    }
+    m_positioned[word(_mark.layout)] = false;
+    m_wiped_out = no_word;
+    p_grid.unset(_mark.layout);
+  }
+
+  /// \brief Evaluates positioning the word of \p p_layout at
+  /// \p p_placement, without positioning it
+  ///
+  /// \param p_created number of legal places of the words not positioned that
+  /// would cross the word, i.e., that have, in a cell it would fill, the same
+  /// letter, and the other orientation
+  ///
+  /// \param p_blocked number of legal places of the words not positioned that
+  /// would become illegal
+  void lookahead(const t_grid &p_grid, const_layout_ite p_layout,
+                 const placement &p_placement, size_t &p_created,
+                 size_t &p_blocked) {
+    p_created = 0;
+    p_blocked = 0;
+    collect_filled(p_grid, p_layout, p_placement);
+
+    const size_t _self{word(p_layout)};
+    const bool _vertical{p_placement.orientation == typ::orientation::vert};
+
+    // first the slots blocked, so a slot is counted once, and a blocked slot
+    // is not counted as created
+    for (const filled_cell &_cell : m_filled) {
+      for (size_t _word = 0; _word < m_num_words; ++_word) {
+        if (m_positioned[_word] || (_word == _self)) {
+          continue;
+        }
+        for_each_covering_slot(
+            _cell, _word, [&](size_t p_slot, typ::letter p_letter, bool) {
+              const size_t _pos{pos(_word, p_slot)};
+              if (m_legal[_pos] && (p_letter != _cell.letter) &&
+                  !m_marked[_pos]) {
+                mark_slot(_pos);
+                ++p_blocked;
+              }
+            });
+      }
+    }
+
+    for (const filled_cell &_cell : m_filled) {
+      for (size_t _word = 0; _word < m_num_words; ++_word) {
+        if (m_positioned[_word] || (_word == _self)) {
+          continue;
+        }
+        for_each_covering_slot(_cell, _word,
+                               [&](size_t p_slot, typ::letter p_letter,
+                                   bool p_slot_vertical) {
+                                 const size_t _pos{pos(_word, p_slot)};
+                                 if (m_legal[_pos] &&
+                                     (p_letter == _cell.letter) &&
+                                     (p_slot_vertical != _vertical) &&
+                                     !m_marked[_pos]) {
+                                   ++p_created;
+                                 }
+                               });
+      }
+    }
+    unmark_slots();
+  }
+
+  /// \brief Number of places where the word of \p p_layout can be positioned
+  inline size_t get_count(const_layout_ite p_layout) const {
+    return m_counts[word(p_layout)];
+  }
+
+  /// \brief Informs if the word of \p p_layout can be positioned at
+  /// \p p_placement, considering only the cells already filled
+  inline bool is_legal(const_layout_ite p_layout,
+                       const placement &p_placement) const {
+    return m_legal[pos(word(p_layout), slot(p_placement.row, p_placement.col,
+                                            p_placement.orientation))];
+  }
+
+  /// \brief Index of the word that has no place left, or \p no_word
+  inline size_t get_wiped_out() const { return m_wiped_out; }
+
+  /// \brief Calls \p p_function once with the index of each word whose
+  /// position made a place of the word \p p_word illegal
+  template <typename t_function>
+  void for_each_blocker(size_t p_word, t_function p_function) {
+    m_seen.assign(m_num_words, false);
+    for (const trail_entry &_entry : m_trail) {
+      if ((_entry.word == p_word) && !m_seen[_entry.by]) {
+        m_seen[_entry.by] = true;
+        p_function(_entry.by);
+      }
+    }
+  }
+
+  /// \brief Calls \p p_function once with the index of each word of a small
+  /// set of positioned words that, alone, leave no place for the word
+  /// \p p_word, i.e., a conflict set
+  ///
+  /// \details \p for_each_blocker reports the first word that made each place
+  /// illegal, but a place can be illegal because of many words. Here, the
+  /// words are chosen greedily, each one the word that makes illegal most of
+  /// the places not yet made illegal by the words chosen before.
+  template <typename t_function>
+  void for_each_conflict(size_t p_word, t_function p_function) {
+    const auto _layout{std::next(m_begin, p_word)};
+    const typ::index _size{_layout->get_size()};
+
+    // places of the word, made illegal by each positioned word
+    m_blocked.resize(m_num_words);
+    size_t _num_places{0};
+    for (size_t _word = 0; _word < m_num_words; ++_word) {
+      m_blocked[_word].clear();
+    }
+    for (size_t _word = 0; _word < m_num_words; ++_word) {
+      if (!m_positioned[_word]) {
+        continue;
+      }
+      const auto _blocker{std::next(m_begin, _word)};
+      for_each_cell(_blocker->get_row(), _blocker->get_col(),
+                    _blocker->get_orientation(), _blocker->get_size(),
+                    [&](typ::index p_row, typ::index p_col, typ::index p_i) {
+                      const filled_cell _cell{p_row, p_col,
+                                              _blocker->get_letters()[p_i]};
+                      for_each_covering_slot(
+                          _cell, p_word,
+                          [&](size_t p_slot, typ::letter p_letter, bool) {
+                            if (p_letter != _cell.letter) {
+                              m_blocked[_word].push_back(p_slot);
+                            }
+                          });
+                    });
+      std::sort(m_blocked[_word].begin(), m_blocked[_word].end());
+      m_blocked[_word].erase(
+          std::unique(m_blocked[_word].begin(), m_blocked[_word].end()),
+          m_blocked[_word].end());
+    }
+    for (typ::index _row = 0; _row < m_num_rows; ++_row) {
+      _num_places += (_size <= m_num_cols ? m_num_cols - _size + 1 : 0);
+    }
+    for (typ::index _col = 0; _col < m_num_cols; ++_col) {
+      _num_places += (_size <= m_num_rows ? m_num_rows - _size + 1 : 0);
+    }
+
+    m_seen.assign(m_num_words, false);
+    while (_num_places > 0) {
+      size_t _best{no_word};
+      size_t _best_count{0};
+      for (size_t _word = 0; _word < m_num_words; ++_word) {
+        if (m_seen[_word]) {
+          continue;
+        }
+        size_t _count{0};
+        for (size_t _slot : m_blocked[_word]) {
+          _count += (m_marked[pos(p_word, _slot)] ? 0 : 1);
+        }
+        if (_count > _best_count) {
+          _best = _word;
+          _best_count = _count;
+        }
+      }
+      if (_best == no_word) {
+        break;
+      }
+      m_seen[_best] = true;
+      for (size_t _slot : m_blocked[_best]) {
+        const size_t _pos{pos(p_word, _slot)};
+        if (!m_marked[_pos]) {
+          mark_slot(_pos);
+          --_num_places;
+        }
+      }
+      p_function(_best);
+    }
+    unmark_slots();
+  }
+
+  /// \brief Index of the word of \p p_layout
+  inline size_t word(const_layout_ite p_layout) const {
+    return static_cast<size_t>(std::distance(m_begin, p_layout));
+  }
+
+private:
+  struct filled_cell {
+    typ::index row;
+    typ::index col;
+    typ::letter letter;
+  };
+
+  struct trail_entry {
+    size_t word;
+    size_t slot;
+    /// \brief Word whose positioning made \p slot illegal
+    size_t by;
+  };
+
+  struct mark {
+    layout_ite layout;
+    size_t trail_size;
+  };
+
+private:
+  inline size_t pos(size_t p_word, size_t p_slot) const {
+    return p_word * m_num_slots + p_slot;
+  }
+
+  inline size_t hori_slot(typ::index p_row, typ::index p_col) const {
+    return static_cast<size_t>(p_row) * m_num_cols + p_col;
+  }
+
+  inline size_t vert_slot(typ::index p_row, typ::index p_col) const {
+    return static_cast<size_t>(m_num_rows) * m_num_cols + hori_slot(p_row, p_col);
+  }
+
+  inline size_t slot(typ::index p_row, typ::index p_col,
+                     typ::orientation p_orientation) const {
+    return p_orientation == typ::orientation::vert ? vert_slot(p_row, p_col)
+                                                   : hori_slot(p_row, p_col);
+  }
+
+  template <typename t_function>
+  static void for_each_cell(typ::index p_row, typ::index p_col,
+                            typ::orientation p_orientation, typ::index p_size,
+                            t_function p_function) {
+    const bool _vertical{p_orientation == typ::orientation::vert};
+    for (typ::index _i = 0; _i < p_size; ++_i) {
+      p_function(static_cast<typ::index>(p_row + (_vertical ? _i : 0)),
+                 static_cast<typ::index>(p_col + (_vertical ? 0 : _i)), _i);
+    }
+  }
+
+  /// \brief Calls \p p_function for each slot of \p p_word that covers
+  /// \p p_cell, with the letter of the word that would be in the cell, and if
+  /// the slot is vertical
+  template <typename t_function>
+  void for_each_covering_slot(const filled_cell &p_cell, size_t p_word,
+                              t_function p_function) const {
+    const auto _layout{std::next(m_begin, p_word)};
+    const typ::letters &_letters{_layout->get_letters()};
+    const typ::index _size{_layout->get_size()};
+
+    // horizontal slots in the row of the cell
+    const typ::index _first_col{std::max<typ::index>(0, p_cell.col - _size + 1)};
+    const typ::index _last_col{
+        std::min<typ::index>(p_cell.col, m_num_cols - _size)};
+    for (typ::index _col = _first_col; _col <= _last_col; ++_col) {
+      p_function(hori_slot(p_cell.row, _col), _letters[p_cell.col - _col],
+                 false);
+    }
+
+    // vertical slots in the column of the cell
+    const typ::index _first_row{std::max<typ::index>(0, p_cell.row - _size + 1)};
+    const typ::index _last_row{
+        std::min<typ::index>(p_cell.row, m_num_rows - _size)};
+    for (typ::index _row = _first_row; _row <= _last_row; ++_row) {
+      p_function(vert_slot(_row, p_cell.col), _letters[p_cell.row - _row],
+                 true);
+    }
+  }
+
+  /// \brief Fills \p m_filled with the cells that are empty in \p p_grid, and
+  /// would be filled by the word of \p p_layout at \p p_placement
+  void collect_filled(const t_grid &p_grid, const_layout_ite p_layout,
+                      const placement &p_placement) {
+    m_filled.clear();
+    for_each_cell(p_placement.row, p_placement.col, p_placement.orientation,
+                  p_layout->get_size(),
+                  [&](typ::index p_row, typ::index p_col, typ::index p_i) {
+                    if (!p_grid.is_occupied(p_row, p_col)) {
+                      m_filled.push_back(
+                          {p_row, p_col, p_layout->get_letters()[p_i]});
+                    }
+                  });
+  }
+
+  inline void mark_slot(size_t p_pos) {
+    m_marked[p_pos] = true;
+    m_touched.push_back(p_pos);
+  }
+
+  /// \brief Clears the marks set since the last call
+  void unmark_slots() {
+    for (size_t _pos : m_touched) {
+      m_marked[_pos] = false;
+    }
+    m_touched.clear();
+  }
+
+  inline void remove(size_t p_word, size_t p_slot, size_t p_by) {
+    m_legal[pos(p_word, p_slot)] = false;
+    --m_counts[p_word];
+    m_trail.push_back({p_word, p_slot, p_by});
+  }
+
+  /// \brief Removes the slots made illegal by the cells in \p m_filled
+  bool update(layout_ite p_layout) {
+    const size_t _by{word(p_layout)};
+    m_marks.push_back({p_layout, m_trail.size()});
+    m_positioned[_by] = true;
+
+    for (const filled_cell &_cell : m_filled) {
+      for (size_t _word = 0; _word < m_num_words; ++_word) {
+        if (m_positioned[_word]) {
+          continue;
+        }
+        for_each_covering_slot(
+            _cell, _word, [&](size_t p_slot, typ::letter p_letter, bool) {
+              if (m_legal[pos(_word, p_slot)] && (p_letter != _cell.letter)) {
+                remove(_word, p_slot, _by);
+              }
+            });
+      }
+    }
+
+    for (size_t _word = 0; _word < m_num_words; ++_word) {
+      if (!m_positioned[_word] && (m_counts[_word] == 0)) {
+        m_wiped_out = _word;
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  typ::index m_num_rows{0};
+  typ::index m_num_cols{0};
+  size_t m_num_slots{0};
+  size_t m_num_words{0};
+  const_layout_ite m_begin;
+
+  /// \brief For each word, and each slot, if it is legal
+  std::vector<bool> m_legal;
+
+  /// \brief For each word, the number of legal slots
+  std::vector<size_t> m_counts;
+
+  std::vector<bool> m_positioned;
+  std::vector<trail_entry> m_trail;
+  std::vector<mark> m_marks;
+  std::vector<filled_cell> m_filled;
+
+  /// \brief For each word, and each slot, if it was already counted by
+  /// \p lookahead or \p for_each_conflict
+  std::vector<bool> m_marked;
+
+  /// \brief Positions set in \p m_marked, to be cleared by \p unmark_slots
+  std::vector<size_t> m_touched;
+
+  /// \brief Marks the words already reported by \p for_each_blocker and
+  /// \p for_each_conflict
+  std::vector<bool> m_seen;
+
+  /// \brief For each word, the slots of the word given to \p for_each_conflict
+  /// it makes illegal
+  std::vector<std::vector<size_t>> m_blocked;
+  size_t m_wiped_out{no_word};
+};
+
+/// \brief Fills \p p_degrees with the degree of each word of \p p_grid in the
+/// intersection graph, i.e., the number of other words that share at least
+/// one letter with it, however many letters they share
+template <typename t_grid>
+void degrees(std::atomic<bool> &p_stop, const t_grid &p_grid,
+             std::vector<size_t> &p_degrees) {
+  p_degrees.clear();
+  for (auto _layout = p_grid.begin(); _layout != p_grid.end(); ++_layout) {
+    size_t _degree{0};
+    for (auto _other = p_grid.begin(); _other != p_grid.end(); ++_other) {
+      if (_other == _layout) {
+        continue;
+      }
+      for_each_intersection(p_stop, _layout->get_letters(),
+                            _other->get_letters(),
+                            [&_degree](const typ::coordinate &) {
+                              ++_degree;
+                              return true;
+                            });
+    }
+    p_degrees.push_back(_degree);
+  }
+}
+
+} // namespace internal
+
+/// \brief Word selection policy of \p internal::basic_backtracking_organizer
+/// that positions the words in the order of the permutation
+struct next_in_permutation {
+  /// \brief Called before organizing a grid
+  template <typename t_grid>
+  void start(std::atomic<bool> &, const t_grid &) {}
+
+  /// \brief Called when a word has no place left, before undoing the last
+  /// position
+  template <typename t_grid>
+  void conflict(internal::basic_forward_checker<t_grid> &) {}
+
+  /// \brief Chooses the next word to be positioned, and the places where it
+  /// can be positioned
+  ///
+  /// \return the word chosen, or \p p_grid.end() if no word can be positioned
+  template <typename t_grid>
+  typename t_grid::layout_ite operator()(
+      std::atomic<bool> &p_stop, t_grid &p_grid,
+      const std::vector<typename t_grid::const_layout_ite> &p_positioned,
+      std::vector<internal::placement> &p_candidates) {
+    typename t_grid::layout_ite _layout{std::next(p_grid.begin())};
+    while ((_layout != p_grid.end()) && _layout->is_positioned()) {
+      ++_layout;
+    }
+    if (_layout != p_grid.end()) {
+      internal::crossing_candidates(p_stop, p_grid, p_positioned, _layout,
+                                    p_candidates);
+    }
+    return _layout;
+  }
+};
+
+/// \brief Word selection policy of \p internal::basic_backtracking_organizer
+/// that positions first the word with fewer places crossing the words already
+/// positioned
+///
+/// \details Words that have no crossing place at the moment are left for
+/// later, as positioning other words can create places for them. Ties are
+/// broken by the degree of the word in the intersection graph, i.e., the
+/// number of other words it shares a letter with, higher first, and then by
+/// the order of the permutation, or at random.
+///
+/// \tparam t_random if \p true, the remaining ties are broken at random,
+/// with a generator set by \p seed
+template <bool t_random = false> struct basic_most_constrained {
+  template <typename t_grid>
+  void start(std::atomic<bool> &p_stop, const t_grid &p_grid) {
+    internal::degrees(p_stop, p_grid, m_degrees);
+  }
+
+  /// \brief Sets the seed of the generator used to break ties
+  inline void seed(uint64_t p_seed) { m_random.seed(p_seed); }
+
+  template <typename t_grid>
+  void conflict(internal::basic_forward_checker<t_grid> &) {}
+
+  template <typename t_grid>
+  typename t_grid::layout_ite operator()(
+      std::atomic<bool> &p_stop, t_grid &p_grid,
+      const std::vector<typename t_grid::const_layout_ite> &p_positioned,
+      std::vector<internal::placement> &p_candidates) {
+    typename t_grid::layout_ite _best{p_grid.end()};
+    size_t _best_degree{0};
+    size_t _ties{0};
+    p_candidates.clear();
+
+    size_t _word{0};
+    for (auto _layout = p_grid.begin(); !p_stop && (_layout != p_grid.end());
+         ++_layout, ++_word) {
+      if (_layout->is_positioned()) {
+        continue;
+      }
+      internal::crossing_candidates(p_stop, p_grid, p_positioned, _layout,
+                                    m_candidates);
+      if (m_candidates.empty()) {
+        continue;
+      }
+      bool _take{(_best == p_grid.end()) ||
+                 (m_candidates.size() < p_candidates.size()) ||
+                 ((m_candidates.size() == p_candidates.size()) &&
+                  (m_degrees[_word] > _best_degree))};
+      if (_take) {
+        _ties = 1;
+      } else if constexpr (t_random) {
+        // reservoir sampling, so each tied word is chosen with the same
+        // probability
+        if ((m_candidates.size() == p_candidates.size()) &&
+            (m_degrees[_word] == _best_degree)) {
+          _take = (std::uniform_int_distribution<size_t>{0, _ties++}(
+                       m_random) == 0);
+        }
+      }
+      if (_take) {
+        _best = _layout;
+        _best_degree = m_degrees[_word];
+        p_candidates.swap(m_candidates);
+      }
+    }
+    return _best;
+  }
+
+private:
+  std::vector<size_t> m_degrees;
+  std::vector<internal::placement> m_candidates;
+  std::mt19937_64 m_random;
+};
+
+/// \brief Word selection policy that positions first the word with fewer
+/// crossing places, breaking ties by the order of the permutation
+using most_constrained_first = basic_most_constrained<false>;
+
+/// \brief Word selection policy that positions first the word with fewer
+/// crossing places, breaking ties at random
+using random_most_constrained = basic_most_constrained<true>;
+
+/// \brief Word selection policy of \p internal::basic_backtracking_organizer
+/// that learns, from the words that could not be positioned, which words
+/// should be positioned early
+///
+/// \details Each word has a weight, that starts at 1. When a word has no place
+/// left, the weight of that word, and of the words whose positions made its
+/// places illegal, is increased. The increment grows after each conflict, so
+/// older conflicts count less, as in the VSIDS heuristic of SAT solvers.
+///
+/// The word chosen is the one with the highest weight divided by the number
+/// of places crossing the words already positioned. While there are no
+/// conflicts, this is the same as \p most_constrained_first.
+///
+/// The weights are kept by word, so they are carried from one grid to the
+/// next, i.e., from one permutation to the next, organized by the same
+/// organizer.
+struct conflict_directed {
+  /// \brief Default factor applied to the weights at each conflict
+  static constexpr double default_decay{0.8};
+
+  /// \brief Constructor
+  ///
+  /// \param p_decay factor, between 0 and 1, applied to the weights at each
+  /// conflict; the lower it is, the faster old conflicts are forgotten
+  conflict_directed(double p_decay = default_decay)
+      : m_growth(1.0 / p_decay) {}
+
+  template <typename t_grid>
+  void start(std::atomic<bool> &p_stop, const t_grid &p_grid) {
+    save();
+    internal::degrees(p_stop, p_grid, m_degrees);
+    m_words.clear();
+    m_weights.clear();
+    for (auto _layout = p_grid.begin(); _layout != p_grid.end(); ++_layout) {
+      m_words.push_back(_layout->get_word());
+      auto _ite{m_learnt.find(_layout->get_word())};
+      m_weights.push_back(_ite == m_learnt.end() ? 1.0 : _ite->second);
+    }
+  }
+
+  template <typename t_grid>
+  void conflict(internal::basic_forward_checker<t_grid> &p_checker) {
+    const size_t _wiped_out{p_checker.get_wiped_out()};
+    if (_wiped_out >= m_weights.size()) {
+      return;
+    }
+    bump(_wiped_out);
+    p_checker.for_each_blocker(_wiped_out,
+                               [this](size_t p_word) { bump(p_word); });
+    m_increment *= m_growth;
+    if (m_increment > max_increment) {
+      rescale();
+    }
+  }
+
+  template <typename t_grid>
+  typename t_grid::layout_ite operator()(
+      std::atomic<bool> &p_stop, t_grid &p_grid,
+      const std::vector<typename t_grid::const_layout_ite> &p_positioned,
+      std::vector<internal::placement> &p_candidates) {
+    typename t_grid::layout_ite _best{p_grid.end()};
+    double _best_score{0};
+    size_t _best_degree{0};
+    p_candidates.clear();
+
+    size_t _word{0};
+    for (auto _layout = p_grid.begin(); !p_stop && (_layout != p_grid.end());
+         ++_layout, ++_word) {
+      if (_layout->is_positioned()) {
+        continue;
+      }
+      internal::crossing_candidates(p_stop, p_grid, p_positioned, _layout,
+                                    m_candidates);
+      if (m_candidates.empty()) {
+        continue;
+      }
+      const double _score{m_weights[_word] /
+                          static_cast<double>(m_candidates.size())};
+      if ((_best == p_grid.end()) || (_score > _best_score) ||
+          ((_score == _best_score) && (m_degrees[_word] > _best_degree))) {
+        _best = _layout;
+        _best_score = _score;
+        _best_degree = m_degrees[_word];
+        p_candidates.swap(m_candidates);
+      }
+    }
+    return _best;
+  }
+
+  /// \brief Weight learnt for a word, or 1 if it was never in a conflict
+  double get_weight(const typ::word &p_word) {
+    save();
+    auto _ite{m_learnt.find(p_word)};
+    return (_ite == m_learnt.end() ? 1.0 : _ite->second);
+  }
+
+private:
+  /// \brief Weights are divided by this value when the increment exceeds it
+  static constexpr double max_increment{1e100};
+
+  inline void bump(size_t p_word) { m_weights[p_word] += m_increment; }
+
+  /// \brief Keeps the weights of the words of the current grid
+  void save() {
+    for (size_t _word = 0; _word < m_words.size(); ++_word) {
+      m_learnt[m_words[_word]] = m_weights[_word];
+    }
+  }
+
+  void rescale() {
+    for (double &_weight : m_weights) {
+      _weight /= max_increment;
+    }
+    for (auto &_learnt : m_learnt) {
+      _learnt.second /= max_increment;
+    }
+    m_increment /= max_increment;
+  }
+
+private:
+  double m_growth{1.0 / default_decay};
+  double m_increment{1.0};
+
+  /// \brief Weight of each word of all the grids organized
+  std::unordered_map<typ::word, double> m_learnt;
+
+  /// \brief Words of the current grid, and their weights
+  std::vector<typ::word> m_words;
+  std::vector<double> m_weights;
+
+  std::vector<size_t> m_degrees;
+  std::vector<internal::placement> m_candidates;
+};
+
+/// \brief Value ordering policy of \p internal::basic_backtracking_organizer
+/// that tries the places in the order they were found, i.e., in the order of
+/// the intersections with the words already positioned
+struct intersection_order {
+  template <typename t_grid>
+  void operator()(const t_grid &, typename t_grid::const_layout_ite,
+                  internal::basic_forward_checker<t_grid> &,
+                  std::vector<internal::placement> &) {}
+};
+
+/// \brief Value ordering policy of \p internal::basic_backtracking_organizer
+/// that tries the places in a random order, with a generator set by \p seed
+struct random_order {
+  /// \brief Sets the seed of the generator used to shuffle the places
+  inline void seed(uint64_t p_seed) { m_random.seed(p_seed); }
+
+  template <typename t_grid>
+  void operator()(const t_grid &, typename t_grid::const_layout_ite,
+                  internal::basic_forward_checker<t_grid> &,
+                  std::vector<internal::placement> &p_candidates) {
+    std::shuffle(p_candidates.begin(), p_candidates.end(), m_random);
+  }
+
+private:
+  std::mt19937_64 m_random;
+};
+
+/// \brief Value ordering policy of \p internal::basic_backtracking_organizer
+/// that tries first the places that keep more options for the words not yet
+/// positioned
+///
+/// \details Each place is scored, without being positioned, by the number of
+/// new crossing places it creates for the other words, minus the number of
+/// places it takes from them. Places with higher scores are tried first, and
+/// ties keep the order of the intersections.
+struct lookahead_order {
+  template <typename t_grid>
+  void operator()(const t_grid &p_grid,
+                  typename t_grid::const_layout_ite p_layout,
+                  internal::basic_forward_checker<t_grid> &p_checker,
+                  std::vector<internal::placement> &p_candidates) {
+    if (p_candidates.size() < 2) {
+      return;
+    }
+
+    m_scored.clear();
+    for (const internal::placement &_placement : p_candidates) {
+      size_t _created{0};
+      size_t _blocked{0};
+      p_checker.lookahead(p_grid, p_layout, _placement, _created, _blocked);
+      m_scored.push_back({static_cast<int64_t>(_created) -
+                              static_cast<int64_t>(_blocked),
+                          _placement});
+    }
+
+    std::stable_sort(m_scored.begin(), m_scored.end(),
+                     [](const scored &p_a, const scored &p_b) {
+                       return p_a.score > p_b.score;
+                     });
+
+    for (size_t _i = 0; _i < m_scored.size(); ++_i) {
+      p_candidates[_i] = m_scored[_i].place;
+    }
+  }
+
+private:
+  struct scored {
+    int64_t score;
+    internal::placement place;
+  };
+
+private:
+  std::vector<scored> m_scored;
+};
+
+/// \brief Restart schedule of \p internal::basic_restarting_organizer, where
+/// the number of positions of each restart follows the Luby sequence, 1, 1,
+/// 2, 1, 1, 2, 4, 1, 1, 2, ...
+///
+/// \details It is within a logarithmic factor of the best fixed cutoff, when
+/// the distribution of the number of positions needed is not known
+struct luby_schedule {
+  /// \return multiplier of the number of positions of the restart
+  /// \p p_restart, starting at 0
+  uint64_t operator()(uint64_t p_restart) const {
+    uint64_t _i{p_restart + 1};
+    while (true) {
+      uint64_t _k{1};
+      while (((uint64_t{1} << _k) - 1) < _i) {
+        ++_k;
+      }
+      if (((uint64_t{1} << _k) - 1) == _i) {
+        return uint64_t{1} << (_k - 1);
+      }
+      _i -= (uint64_t{1} << (_k - 1)) - 1;
+    }
+  }
+};
+
+/// \brief Restart schedule of \p internal::basic_restarting_organizer, where
+/// the number of positions of each restart grows geometrically
+struct geometric_schedule {
+  /// \brief Default growth of the number of positions between restarts
+  static constexpr double default_factor{1.5};
+
+  geometric_schedule(double p_factor = default_factor) : m_factor(p_factor) {}
+
+  /// \return multiplier of the number of positions of the restart
+  /// \p p_restart, starting at 0
+  uint64_t operator()(uint64_t p_restart) const {
+    const double _multiplier{std::pow(m_factor, static_cast<double>(p_restart))};
+    if (_multiplier >=
+        static_cast<double>(std::numeric_limits<uint32_t>::max())) {
+      return std::numeric_limits<uint32_t>::max();
+    }
+    return static_cast<uint64_t>(_multiplier);
+  }
+
+private:
+  double m_factor{default_factor};
+};
+
+namespace internal {
+
+/// \brief Tries to position all the words of a grid with a depth first
+/// search, that undoes positions instead of starting over
+///
+/// \details For each anchor of the first word, the other words are
+/// positioned crossing the ones already positioned, and a \p
+/// basic_forward_checker detects, right after a word is positioned, if a
+/// word not yet positioned has no place left, so the search backtracks
+/// before reaching it.
+///
+/// \tparam t_grid type of grid, like \p typ::grid or \p typ::fixed_grid
+///
+/// \tparam t_word_selection chooses the next word to be positioned, like
+/// \p next_in_permutation, \p most_constrained_first or
+/// \p conflict_directed
+///
+/// \tparam t_anchors template, on the type of grid, of the positioner of the
+/// first word, like \p row_major_anchors
+///
+/// \tparam t_value_order orders the places of the word chosen, like
+/// \p intersection_order or \p lookahead_order
+///
+/// Only what the \p basic_forward_checker proves is learned: when positioning
+/// a word leaves another word with no place, no grid with the words that took
+/// its places at the same places can be organized, whatever the order the
+/// words are positioned, the word selection policy, or the permutation.
+///
+/// When a \p typ::nogood_store is set, a conflict set, i.e., the positions of
+/// a few words that, together, took all the places, chosen by
+/// \p basic_forward_checker::for_each_conflict, and the word left with no
+/// place, is kept in it, if it has up to \p max_nogood_size elements. A
+/// position that would complete a set kept, by this organizer or by an
+/// organizer in another thread, is not tried.
+///
+/// When a \p typ::transposition_table is set, the Zobrist hash of the grid
+/// where a word was left with no place is kept in it, and a position that
+/// would lead to a grid with the same hash is not tried, as the same words at
+/// the same places can be reached by positioning them in another order.
+template <typename t_grid, typename t_word_selection = next_in_permutation,
+          template <typename> typename t_anchors = row_major_anchors,
+          typename t_value_order = intersection_order>
+struct basic_backtracking_organizer {
+  using layout_ite = typename t_grid::layout_ite;
+  using const_layout_ite = typename t_grid::const_layout_ite;
+
+  /// \brief Default maximum number of positions tried for a grid
+  static constexpr uint64_t default_max_nodes{100000};
+
+  /// \brief Maximum number of elements of a conflict set kept in the
+  /// \p typ::nogood_store, counting the word left with no place
+  static constexpr size_t max_nogood_size{10};
+
+  /// \brief Constructor
+  ///
+  /// \param p_max_nodes maximum number of positions tried for a grid, before
+  /// giving it up
+  basic_backtracking_organizer(uint64_t p_max_nodes = default_max_nodes)
+      : m_max_nodes(p_max_nodes) {}
+
+  ~basic_backtracking_organizer() = default;
+
+  bool operator()(std::shared_ptr<t_grid> p_grid) {
+    // the counters are of the last grid, even if it is refused
+    m_nodes = 0;
+    m_pruned = 0;
+
+    if (m_stop) {
+      TNCT_LOG_TRA("backtracking organizer ", this, ": stopped");
+      return false;
+    }
+
+    if (p_grid->empty()) {
+      TNCT_LOG_TRA("backtracking organizer ", this, ": no words to position");
+      return false;
+    }
+
+    if (!two_first_words_intersect(m_stop, *p_grid)) {
+      TNCT_LOG_TRA("backtracking organizer ", this,
+                   ": no organization possible because no word intersects '",
+                   p_grid->begin()->get_word(), '\'');
+      return false;
+    }
+
+    p_grid->reset_positions();
+
+    m_num_words =
+        static_cast<size_t>(std::distance(p_grid->begin(), p_grid->end()));
+    m_candidates.resize(m_num_words);
+    m_word_selection.start(m_stop, *p_grid);
+    m_dimensions_key = typ::position_key(0, p_grid->get_num_rows(),
+                                         p_grid->get_num_cols(),
+                                         typ::orientation::undef);
+
+    t_anchors<t_grid> _anchors;
+    internal::seed(_anchors, typ::mix(m_seed + 3));
+
+    while (!m_stop && (m_nodes < m_max_nodes) && _anchors(m_stop, *p_grid)) {
+      m_checker.start(*p_grid);
+      m_positioned.clear();
+      m_positioned.push_back(p_grid->begin());
+
+      if (!m_checker.anchor(p_grid->begin())) {
+        m_word_selection.conflict(m_checker);
+      } else {
+        if (search(*p_grid) && p_grid->organized()) {
+          TNCT_LOG_TRA("backtracking organizer ", this,
+                       ": SUCCESS! setting to stop: ", *p_grid);
+          m_stop = true;
+          return true;
+        }
+      }
+      if (m_stop) {
+        break;
+      }
+      p_grid->reset_positions();
+    }
+
+    TNCT_LOG_TRA("backtracking organizer ", this, ": could not organize after ",
+                 m_nodes, " positions");
+    return false;
+  }
+
+  inline void stop() { m_stop = true; }
+
+  /// \brief Sets the seed of the policies that have a random generator
+  ///
+  /// \details Each policy gets its own seed, derived from \p p_seed, so the
+  /// same seed reproduces the same search
+  void seed(uint64_t p_seed) {
+    m_seed = p_seed;
+    internal::seed(m_word_selection, typ::mix(m_seed + 1));
+    internal::seed(m_value_order, typ::mix(m_seed + 2));
+  }
+
+  /// \brief Sets the maximum number of positions tried for a grid
+  inline void set_max_nodes(uint64_t p_max_nodes) { m_max_nodes = p_max_nodes; }
+
+  /// \brief Sets where the sets of positions from which no organization was
+  /// found are kept, usually shared with organizers in other threads
+  inline void set_nogoods(std::shared_ptr<typ::nogood_store> p_nogoods) {
+    m_nogoods = std::move(p_nogoods);
+  }
+
+  /// \brief Sets where the grids from which no organization was found are
+  /// kept, usually shared with organizers in other threads
+  inline void
+  set_transpositions(std::shared_ptr<typ::transposition_table> p_transpositions) {
+    m_transpositions = std::move(p_transpositions);
+  }
+
+  /// \brief Number of positions tried in the last grid
+  inline uint64_t get_num_nodes() const { return m_nodes; }
+
+  /// \brief Number of positions, in the last grid, not tried because of the
+  /// \p typ::nogood_store or the \p typ::transposition_table
+  inline uint64_t get_num_pruned() const { return m_pruned; }
+
+private:
+  bool search(t_grid &p_grid) {
+    if (m_positioned.size() == m_num_words) {
+      return true;
+    }
+
+    std::vector<placement> &_candidates{m_candidates[m_positioned.size()]};
+    layout_ite _word{
+        m_word_selection(m_stop, p_grid, m_positioned, _candidates)};
+    if (_word == p_grid.end()) {
+      return false;
+    }
+
+    m_value_order(p_grid, _word, m_checker, _candidates);
+
+    for (const placement &_placement : _candidates) {
+      if (m_stop) {
+        return false;
+      }
+      const uint64_t _transposition{
+          p_grid.get_hash() ^ m_dimensions_key ^
+          typ::position_key(_word->get_key(), _placement.row, _placement.col,
+                            _placement.orientation)};
+      if (proved_to_fail(p_grid, _word, _placement, _transposition)) {
+        ++m_pruned;
+        continue;
+      }
+      if (++m_nodes > m_max_nodes) {
+        return false;
+      }
+      if (m_checker.place(p_grid, _word, _placement)) {
+        m_positioned.push_back(_word);
+        if (search(p_grid)) {
+          return true;
+        }
+        m_positioned.pop_back();
+      } else {
+        m_word_selection.conflict(m_checker);
+        learn(p_grid, _transposition);
+      }
+      m_checker.undo(p_grid);
+    }
+    return false;
+  }
+
+  /// \brief Informs if positioning the word of \p p_layout at \p p_placement
+  /// leads to a grid kept in the \p typ::transposition_table, or completes a
+  /// conflict set kept in the \p typ::nogood_store
+  ///
+  /// \param p_transposition Zobrist hash of the grid after the position
+  bool proved_to_fail(const t_grid &p_grid, const_layout_ite p_layout,
+                      const placement &p_placement, uint64_t p_transposition) {
+    if (m_transpositions && m_transpositions->failed(p_transposition)) {
+      return true;
+    }
+    if (!m_nogoods) {
+      return false;
+    }
+    m_set.clear();
+    for (auto _layout = p_grid.begin(); _layout != p_grid.end(); ++_layout) {
+      m_set.push_back(_layout == p_layout
+                          ? typ::nogood_store::position_key(
+                                p_layout->get_key(), p_placement.row,
+                                p_placement.col, p_placement.orientation)
+                          : nogood_key(_layout));
+    }
+    std::sort(m_set.begin(), m_set.end());
+    return m_nogoods->contains_subset(m_dimensions_key, m_set.begin(),
+                                      m_set.end());
+  }
+
+  /// \brief Keeps what the \p basic_forward_checker proved when the last
+  /// position left a word with no place
+  ///
+  /// \param p_transposition Zobrist hash of the grid after the position
+  void learn(const t_grid &p_grid, uint64_t p_transposition) {
+    if (m_transpositions) {
+      m_transpositions->store(p_transposition,
+                              static_cast<typ::transposition_table::depth>(
+                                  m_num_words - m_positioned.size() - 1));
+    }
+    const size_t _wiped_out{m_checker.get_wiped_out()};
+    if (!m_nogoods || (_wiped_out == m_checker.no_word)) {
+      return;
+    }
+    m_set.clear();
+    m_set.push_back(nogood_key(std::next(p_grid.begin(), _wiped_out)));
+    m_checker.for_each_conflict(_wiped_out, [&](size_t p_word) {
+      m_set.push_back(nogood_key(std::next(p_grid.begin(), p_word)));
+    });
+    if (m_set.size() <= max_nogood_size) {
+      std::sort(m_set.begin(), m_set.end());
+      m_nogoods->insert_set(m_dimensions_key, m_set.begin(), m_set.end());
+    }
+  }
+
+  /// \brief Key of the position of the word of \p p_layout in a conflict set,
+  /// or of the word itself, if it is not positioned
+  static inline typ::nogood_store::key nogood_key(const_layout_ite p_layout) {
+    return p_layout->is_positioned()
+               ? typ::nogood_store::position_key(
+                     p_layout->get_key(), p_layout->get_row(),
+                     p_layout->get_col(), p_layout->get_orientation())
+               : typ::nogood_store::position_key(p_layout->get_key(), 0, 0,
+                                                 typ::orientation::undef);
+  }
+
+private:
+  std::atomic<bool> m_stop{false};
+  uint64_t m_max_nodes{default_max_nodes};
+  uint64_t m_seed{0};
+  uint64_t m_nodes{0};
+  uint64_t m_pruned{0};
+  size_t m_num_words{0};
+  basic_forward_checker<t_grid> m_checker;
+  t_word_selection m_word_selection;
+  t_value_order m_value_order;
+
+  /// \brief Words positioned, in the order they were positioned
+  std::vector<const_layout_ite> m_positioned;
+
+  /// \brief Places for the word being positioned, one collection per depth
+  std::vector<std::vector<placement>> m_candidates;
+
+  std::shared_ptr<typ::nogood_store> m_nogoods;
+  std::shared_ptr<typ::transposition_table> m_transpositions;
+
+  /// \brief Key of the dimensions of the grid
+  uint64_t m_dimensions_key{0};
+
+  /// \brief Keys of a conflict set, or of the positions of all the words
+  std::vector<typ::nogood_store::key> m_set;
+};
+
+using backtracking_organizer = basic_backtracking_organizer<typ::grid>;
+
+/// \brief Tries to position all the words of a grid with randomized depth
+/// first searches, restarted after a number of positions
+///
+/// \details A depth first search can spend most of its positions below a bad
+/// choice made near the root, while another order of the same words would be
+/// organized quickly. Each restart runs a \p basic_backtracking_organizer,
+/// with the ties of the word selection, the places of the words, and the
+/// anchors of the first word shuffled with a different seed, and stops it
+/// after \p p_unit times the value of \p t_schedule for that restart
+/// positions. When a \p typ::nogood_store or a \p typ::transposition_table
+/// is set, what a restart learned is used by the next ones.
+///
+/// \tparam t_grid type of grid, like \p typ::grid or \p typ::fixed_grid
+///
+/// \tparam t_schedule number of positions of each restart, in units, like
+/// \p luby_schedule or \p geometric_schedule
+///
+/// \tparam t_word_selection, t_anchors, t_value_order policies of
+/// \p basic_backtracking_organizer, which should have a \p seed method, or
+/// all the restarts will be the same search
+template <typename t_grid, typename t_schedule = luby_schedule,
+          typename t_word_selection = random_most_constrained,
+          template <typename> typename t_anchors = random_anchors,
+          typename t_value_order = random_order>
+struct basic_restarting_organizer {
+  /// \brief Default number of positions of a unit of the schedule
+  static constexpr uint64_t default_unit{100};
+
+  /// \brief Constructor
+  ///
+  /// \param p_unit number of positions multiplied by the value of the
+  /// schedule for each restart
+  ///
+  /// \param p_max_nodes maximum number of positions tried for a grid, in all
+  /// the restarts, before giving it up
+  ///
+  /// \param p_seed seed of the first restart, usually changed by the
+  /// \p assembler for each thread
+  basic_restarting_organizer(
+      uint64_t p_unit = default_unit,
+      uint64_t p_max_nodes =
+          basic_backtracking_organizer<t_grid>::default_max_nodes,
+      uint64_t p_seed = 0, t_schedule p_schedule = t_schedule{})
+      : m_unit(p_unit), m_max_nodes(p_max_nodes), m_seed(p_seed),
+        m_schedule(p_schedule) {}
+
+  ~basic_restarting_organizer() = default;
+
+  bool operator()(std::shared_ptr<t_grid> p_grid) {
+    m_nodes = 0;
+    m_restarts = 0;
+    while (!m_stop && (m_nodes < m_max_nodes)) {
+      const uint64_t _cutoff{std::min(
+          std::max(m_unit * m_schedule(m_restarts), uint64_t{1}),
+          m_max_nodes - m_nodes)};
+      m_organizer.set_max_nodes(_cutoff);
+      m_organizer.seed(typ::mix(m_seed + m_restarts));
+      ++m_restarts;
+
+      if (m_organizer(p_grid)) {
+        m_nodes += m_organizer.get_num_nodes();
+        TNCT_LOG_TRA("restarting organizer ", this, ": SUCCESS after ",
+                     m_restarts, " restarts");
+        m_stop = true;
+        return true;
+      }
+      m_nodes += std::min(m_organizer.get_num_nodes(), _cutoff);
+      if (m_organizer.get_num_nodes() < _cutoff) {
+        // all the anchors were tried before the cutoff, so other seeds would
+        // just shuffle a search that fails
+        break;
+      }
+    }
+    TNCT_LOG_TRA("restarting organizer ", this, ": could not organize after ",
+                 m_restarts, " restarts and ", m_nodes, " positions");
+    return false;
+  }
+
+  inline void stop() {
+    m_stop = true;
+    m_organizer.stop();
+  }
+
+  /// \brief Sets the seed of the first restart
+  inline void seed(uint64_t p_seed) { m_seed = p_seed; }
+
+  /// \brief Sets where the sets of positions from which no organization was
+  /// found are kept, usually shared with organizers in other threads
+  inline void set_nogoods(std::shared_ptr<typ::nogood_store> p_nogoods) {
+    m_organizer.set_nogoods(std::move(p_nogoods));
+  }
+
+  /// \brief Sets where the grids from which no organization was found are
+  /// kept, usually shared with organizers in other threads
+  inline void
+  set_transpositions(std::shared_ptr<typ::transposition_table> p_transpositions) {
+    m_organizer.set_transpositions(std::move(p_transpositions));
+  }
+
+  /// \brief Number of positions tried in the last grid, in all the restarts
+  inline uint64_t get_num_nodes() const { return m_nodes; }
+
+  /// \brief Number of restarts in the last grid
+  inline uint64_t get_num_restarts() const { return m_restarts; }
+
+private:
+  std::atomic<bool> m_stop{false};
+  uint64_t m_unit{default_unit};
+  uint64_t m_max_nodes{0};
+  uint64_t m_seed{0};
+  t_schedule m_schedule;
+  uint64_t m_nodes{0};
+  uint64_t m_restarts{0};
+  basic_backtracking_organizer<t_grid, t_word_selection, t_anchors,
+                               t_value_order>
+      m_organizer;
+};
+
+using restarting_organizer = basic_restarting_organizer<typ::grid>;
+
+} // namespace internal
+
+} // namespace tenacitas::lib::crosswords::bus
+
+#endif
@@ -0,0 +1,356 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_ALG_BEAM_SEARCHER_H
+#define TENACITAS_LIB_CROSSWORDS_ALG_BEAM_SEARCHER_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <tenacitas.lib.crosswords/alg/assembler.h>
+#include <tenacitas.lib.crosswords/typ/grid.h>
+#include <tenacitas.lib.log/alg/logger.h>
+
+namespace tenacitas::lib::crosswords::bus {
+
+/// \brief Heuristic of \p basic_beam_searcher that prefers grids where the
+/// words not yet positioned have more places to cross the others
+///
+/// \details The score is the sum, for each word not positioned, of the
+/// logarithm of 1 plus the number of places where it can be positioned
+/// crossing the words positioned, minus \p dead_penalty for each word with
+/// no place, plus \p crossing_weight for each cell shared by two words.
+struct flexibility_heuristic {
+  static constexpr double dead_penalty{4.0};
+  static constexpr double crossing_weight{0.25};
+
+  template <typename t_grid>
+  double operator()(
+      std::atomic<bool> &p_stop, const t_grid &p_grid,
+      const std::vector<typename t_grid::const_layout_ite> &p_positioned,
+      std::vector<internal::placement> &p_candidates) const {
+    double _score{0};
+    size_t _letters{0};
+    for (auto _layout = p_grid.begin(); _layout != p_grid.end(); ++_layout) {
+      if (_layout->is_positioned()) {
+        _letters += static_cast<size_t>(_layout->get_size());
+        continue;
+      }
+      internal::crossing_candidates(p_stop, p_grid, p_positioned, _layout,
+                                    p_candidates);
+      if (p_candidates.empty()) {
+        _score -= dead_penalty;
+      } else {
+        _score += std::log(1.0 + static_cast<double>(p_candidates.size()));
+      }
+    }
+
+    // each shared cell has the letters of two words
+    size_t _occupied{0};
+    for (typ::index _row = 0; _row < p_grid.get_num_rows(); ++_row) {
+      for (typ::letter _letter : p_grid.get_row(_row)) {
+        _occupied += (_letter != typ::max_char) ? 1 : 0;
+      }
+    }
+    return _score +
+           (crossing_weight * static_cast<double>(_letters - _occupied));
+  }
+};
+
+/// \brief Tries to position all the words of a grid keeping, at each depth,
+/// only the best \p p_width partial grids
+///
+/// \details The first level has the places of the longest word. At each
+/// level, the word with fewer places crossing the words positioned is chosen
+/// in each grid of the beam, and each of its places is a child, scored by
+/// \p t_heuristic. Children with the same words at the same places, as
+/// detected by their Zobrist hash, are kept once, and only the best
+/// \p p_width become the next level. The grids of a level are expanded in
+/// parallel, each worker positioning the word in its grids, scoring, and
+/// removing it, so only the \p p_width children selected are copied.
+///
+/// Memory is bounded by \p p_width grids, plus the places of their children,
+/// and the time by the number of words times \p p_width times the number of
+/// places of a word. The search is not complete: an organization may be
+/// lost if it is not among the best \p p_width at some level. In that case,
+/// like \p basic_annealer, the grid returned has not all the words positioned:
+/// it is the best grid of the last level that had grids.
+///
+/// \tparam t_grid type of grid, like \p typ::grid, or \p typ::fixed_grid
+///
+/// \tparam t_heuristic scores a partial grid, higher is better, like
+/// \p flexibility_heuristic
+template <typename t_grid, typename t_heuristic = flexibility_heuristic>
+struct basic_beam_searcher {
+  using layout_ite = typename t_grid::layout_ite;
+  using const_layout_ite = typename t_grid::const_layout_ite;
+
+  /// \brief Default number of grids kept at each depth
+  static constexpr size_t default_width{32};
+
+  basic_beam_searcher(t_heuristic p_heuristic = t_heuristic{})
+      : m_heuristic(p_heuristic) {}
+
+  basic_beam_searcher(const basic_beam_searcher &) = delete;
+  basic_beam_searcher(basic_beam_searcher &&) = delete;
+  basic_beam_searcher &operator=(const basic_beam_searcher &) = delete;
+  basic_beam_searcher &operator=(basic_beam_searcher &&) = delete;
+  ~basic_beam_searcher() = default;
+
+  /// \brief Tries to position all the words of \p p_entries in a grid
+  ///
+  /// \param p_entries entries used to assemble the grid
+  ///
+  /// \param p_num_rows number of rows of the grid
+  ///
+  /// \param p_num_cols number of columns of the grid
+  ///
+  /// \param p_width number of grids kept at each depth
+  ///
+  /// \param p_num_workers number of threads that expand the grids of a level
+  ///
+  /// \return the grid organized, or the grid with the best score of the last
+  /// level that had grids, if the beam got empty or the search was stopped,
+  /// or \p nullptr if it was not possible to create the grid
+  std::shared_ptr<t_grid>
+  start(const typ::entries &p_entries, typ::index p_num_rows,
+        typ::index p_num_cols, size_t p_width = default_width,
+        size_t p_num_workers = std::max(std::thread::hardware_concurrency(),
+                                        1U)) {
+    m_stop = false;
+    m_num_expanded = 0;
+    m_depth = 0;
+    m_entries = p_entries;
+    std::stable_sort(m_entries.begin(), m_entries.end(),
+                     [](const typ::entry &p_e1, const typ::entry &p_e2) {
+                       return typ::get_size(p_e1.get_word()) >
+                              typ::get_size(p_e2.get_word());
+                     });
+
+    typ::permutation _permutation;
+    for (typ::entries::const_entry_ite _entry = m_entries.begin();
+         _entry != m_entries.end(); ++_entry) {
+      _permutation.push_back(_entry);
+    }
+    if (_permutation.empty()) {
+      TNCT_LOG_ERR("no words to position");
+      return nullptr;
+    }
+
+    std::vector<std::shared_ptr<t_grid>> _beam;
+    try {
+      _beam.push_back(
+          std::make_shared<t_grid>(_permutation, p_num_rows, p_num_cols));
+    } catch (std::exception &_ex) {
+      TNCT_LOG_ERR(_ex.what());
+      return nullptr;
+    }
+    const size_t _num_words{_permutation.size()};
+    m_workers.resize(std::max(p_num_workers, size_t{1}));
+
+    for (m_depth = 0; (m_depth < _num_words) && !m_stop; ++m_depth) {
+      std::vector<child> _children{expand(_beam)};
+      if (_children.empty()) {
+        TNCT_LOG_TRA("beam searcher: no grid at depth ", m_depth,
+                     ", returning the best of the previous depth");
+        return _beam.front();
+      }
+      select(_children, p_width);
+      _beam = materialize(_beam, _children);
+    }
+
+    if (m_stop) {
+      return _beam.front();
+    }
+    TNCT_LOG_TRA("beam searcher: organized after expanding ", m_num_expanded,
+                 " grids");
+    return _beam.front();
+  }
+
+  /// \brief Stops the search
+  inline void stop() { m_stop = true; }
+
+  /// \brief Number of children scored in the last \p start
+  inline uint64_t get_num_expanded() const { return m_num_expanded; }
+
+  /// \brief Depth reached in the last \p start
+  inline size_t get_depth() const { return m_depth; }
+
+private:
+  /// \brief A grid of the next level, not yet copied
+  struct child {
+    size_t parent;
+    size_t word;
+    internal::placement place;
+    double score;
+    uint64_t hash;
+  };
+
+  /// \brief What a worker uses while expanding, to avoid allocations
+  struct worker {
+    std::vector<child> children;
+    std::vector<const_layout_ite> positioned;
+    std::vector<internal::placement> candidates;
+    std::vector<internal::placement> best;
+  };
+
+private:
+  /// \brief Calls \p p_function for the indexes from 0 to \p p_size - 1,
+  /// split among the workers
+  template <typename t_function>
+  void parallel(size_t p_size, t_function p_function) {
+    const size_t _num_workers{std::min(m_workers.size(), p_size)};
+    if (_num_workers <= 1) {
+      for (size_t _i = 0; _i < p_size; ++_i) {
+        p_function(m_workers[0], _i);
+      }
+      return;
+    }
+    std::vector<std::thread> _threads;
+    for (size_t _w = 0; _w < _num_workers; ++_w) {
+      _threads.emplace_back([this, _w, _num_workers, p_size, &p_function]() {
+        for (size_t _i = _w; _i < p_size; _i += _num_workers) {
+          p_function(m_workers[_w], _i);
+        }
+      });
+    }
+    for (std::thread &_thread : _threads) {
+      _thread.join();
+    }
+  }
+
+  std::vector<child> expand(std::vector<std::shared_ptr<t_grid>> &p_beam) {
+    for (worker &_worker : m_workers) {
+      _worker.children.clear();
+    }
+
+    parallel(p_beam.size(), [&](worker &p_worker, size_t p_parent) {
+      if (m_stop) {
+        return;
+      }
+      t_grid &_grid{*p_beam[p_parent]};
+      p_worker.positioned.clear();
+      for (const_layout_ite _layout = _grid.begin(); _layout != _grid.end();
+           ++_layout) {
+        if (_layout->is_positioned()) {
+          p_worker.positioned.push_back(_layout);
+        }
+      }
+
+      layout_ite _word{choose(p_worker, _grid)};
+      if (_word == _grid.end()) {
+        return;
+      }
+      const size_t _index{static_cast<size_t>(_word - _grid.begin())};
+      p_worker.positioned.push_back(_word);
+      for (const internal::placement &_place : p_worker.best) {
+        _grid.set(_word, _place.row, _place.col, _place.orientation);
+        p_worker.children.push_back(
+            {p_parent, _index, _place,
+             m_heuristic(m_stop, _grid, p_worker.positioned,
+                         p_worker.candidates),
+             _grid.get_hash()});
+        _grid.unset(_word);
+      }
+    });
+
+    std::vector<child> _children;
+    for (worker &_worker : m_workers) {
+      _children.insert(_children.end(), _worker.children.begin(),
+                       _worker.children.end());
+    }
+    m_num_expanded += _children.size();
+    return _children;
+  }
+
+  /// \brief Chooses the word with fewer places crossing the words
+  /// positioned, leaving its places in \p p_worker.best
+  ///
+  /// \return the word, or \p p_grid.end() if no word can be positioned
+  layout_ite choose(worker &p_worker, t_grid &p_grid) {
+    p_worker.best.clear();
+    if (p_worker.positioned.empty()) {
+      // first level: all the places of the first word
+      layout_ite _first{p_grid.begin()};
+      internal::basic_canonical_positioner<t_grid> _anchors;
+      while (_anchors(m_stop, p_grid)) {
+        p_worker.best.push_back(
+            {_first->get_row(), _first->get_col(), _first->get_orientation()});
+        p_grid.unset(_first);
+      }
+      return p_worker.best.empty() ? p_grid.end() : _first;
+    }
+
+    layout_ite _best{p_grid.end()};
+    for (layout_ite _layout = p_grid.begin(); _layout != p_grid.end();
+         ++_layout) {
+      if (_layout->is_positioned()) {
+        continue;
+      }
+      internal::crossing_candidates(m_stop, p_grid, p_worker.positioned,
+                                    _layout, p_worker.candidates);
+      if (p_worker.candidates.empty()) {
+        continue;
+      }
+      if ((_best == p_grid.end()) ||
+          (p_worker.candidates.size() < p_worker.best.size())) {
+        _best = _layout;
+        p_worker.best.swap(p_worker.candidates);
+      }
+    }
+    return _best;
+  }
+
+  /// \brief Keeps the best \p p_width children, one for each hash
+  void select(std::vector<child> &p_children, size_t p_width) {
+    std::stable_sort(p_children.begin(), p_children.end(),
+                     [](const child &p_c1, const child &p_c2) {
+                       return p_c1.score > p_c2.score;
+                     });
+    std::unordered_set<uint64_t> _hashes;
+    size_t _kept{0};
+    for (size_t _i = 0; (_i < p_children.size()) && (_kept < p_width); ++_i) {
+      if (_hashes.insert(p_children[_i].hash).second) {
+        p_children[_kept++] = p_children[_i];
+      }
+    }
+    p_children.resize(_kept);
+  }
+
+  std::vector<std::shared_ptr<t_grid>>
+  materialize(const std::vector<std::shared_ptr<t_grid>> &p_beam,
+              const std::vector<child> &p_children) {
+    std::vector<std::shared_ptr<t_grid>> _beam(p_children.size());
+    parallel(p_children.size(), [&](worker &, size_t p_child) {
+      const child &_child{p_children[p_child]};
+      _beam[p_child] = std::make_shared<t_grid>(*p_beam[_child.parent]);
+      _beam[p_child]->set(std::next(_beam[p_child]->begin(), _child.word),
+                          _child.place.row, _child.place.col,
+                          _child.place.orientation);
+    });
+    return _beam;
+  }
+
+private:
+  t_heuristic m_heuristic;
+  std::atomic<bool> m_stop{false};
+  uint64_t m_num_expanded{0};
+  size_t m_depth{0};
+  typ::entries m_entries;
+  std::vector<worker> m_workers;
+};
+
+using beam_searcher = basic_beam_searcher<typ::grid>;
+
+} // namespace tenacitas::lib::crosswords::bus
+
+#endif
@@ -0,0 +1,707 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_ALG_CLUSTERER_H
+#define TENACITAS_LIB_CROSSWORDS_ALG_CLUSTERER_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <tenacitas.lib.crosswords/alg/assembler.h>
+#include <tenacitas.lib.crosswords/alg/backtracking_organizer.h>
+#include <tenacitas.lib.crosswords/typ/grid.h>
+#include <tenacitas.lib.log/alg/logger.h>
+
+namespace tenacitas::lib::crosswords::bus {
+
+namespace internal {
+
+/// \brief Partitions the words in clusters of up to \p p_max_size words,
+/// where the words of a cluster share many letters
+///
+/// \details Each word starts in its own cluster, and the two clusters with
+/// the highest average number of letters shared by a word of one and a word
+/// of the other are merged, while there are two clusters that share letters
+/// and have up to \p p_max_size words together. So the words of a cluster
+/// are connected in the intersection graph.
+///
+/// \param p_crossings number of letters shared by the words \p i and \p j at
+/// \p i * n + \p j, where \p n is the number of words
+///
+/// \return the indexes of the words of each cluster, from the one with more
+/// words
+std::vector<std::vector<size_t>>
+cluster_words(const std::vector<size_t> &p_crossings, size_t p_num_words,
+              size_t p_max_size) {
+  std::vector<std::vector<size_t>> _clusters(p_num_words);
+  for (size_t _word = 0; _word < p_num_words; ++_word) {
+    _clusters[_word].push_back(_word);
+  }
+
+  // letters shared by the words of each pair of clusters
+  std::vector<size_t> _shared(p_crossings);
+
+  while (true) {
+    size_t _best1{p_num_words};
+    size_t _best2{p_num_words};
+    double _best_linkage{0.0};
+    for (size_t _c1 = 0; _c1 < p_num_words; ++_c1) {
+      if (_clusters[_c1].empty()) {
+        continue;
+      }
+      for (size_t _c2 = _c1 + 1; _c2 < p_num_words; ++_c2) {
+        if (_clusters[_c2].empty() ||
+            (_clusters[_c1].size() + _clusters[_c2].size() > p_max_size) ||
+            (_shared[_c1 * p_num_words + _c2] == 0)) {
+          continue;
+        }
+        const double _linkage{
+            static_cast<double>(_shared[_c1 * p_num_words + _c2]) /
+            static_cast<double>(_clusters[_c1].size() * _clusters[_c2].size())};
+        if (_linkage > _best_linkage) {
+          _best1 = _c1;
+          _best2 = _c2;
+          _best_linkage = _linkage;
+        }
+      }
+    }
+    if (_best1 == p_num_words) {
+      break;
+    }
+
+    _clusters[_best1].insert(_clusters[_best1].end(),
+                             _clusters[_best2].begin(),
+                             _clusters[_best2].end());
+    _clusters[_best2].clear();
+    for (size_t _other = 0; _other < p_num_words; ++_other) {
+      _shared[_best1 * p_num_words + _other] +=
+          _shared[_best2 * p_num_words + _other];
+      _shared[_other * p_num_words + _best1] =
+          _shared[_best1 * p_num_words + _other];
+    }
+  }
+
+  _clusters.erase(std::remove_if(_clusters.begin(), _clusters.end(),
+                                 [](const std::vector<size_t> &p_cluster) {
+                                   return p_cluster.empty();
+                                 }),
+                  _clusters.end());
+  std::stable_sort(_clusters.begin(), _clusters.end(),
+                   [](const std::vector<size_t> &p_c1,
+                      const std::vector<size_t> &p_c2) {
+                     return p_c1.size() > p_c2.size();
+                   });
+  return _clusters;
+}
+
+/// \brief Words of a cluster positioned in a sub-grid, where the first row
+/// and the first column are used
+struct sub_grid {
+  struct position {
+    size_t word{0};
+    typ::index row{0};
+    typ::index col{0};
+    typ::orientation orientation{typ::orientation::undef};
+  };
+
+  std::vector<position> positions;
+};
+
+/// \brief Letters of the cells of a grid, and how many horizontal and
+/// vertical words use each one, so sub-grids can be placed and removed
+struct stitch_board {
+  static constexpr typ::letter empty_cell{typ::max_char};
+
+  stitch_board(typ::index p_num_rows, typ::index p_num_cols)
+      : m_num_rows(p_num_rows), m_num_cols(p_num_cols),
+        m_letters(static_cast<size_t>(p_num_rows) * p_num_cols, empty_cell),
+        m_hori(m_letters.size(), 0), m_vert(m_letters.size(), 0) {}
+
+  inline typ::index get_num_rows() const { return m_num_rows; }
+  inline typ::index get_num_cols() const { return m_num_cols; }
+
+  /// \brief Number of cells of the word of letters \p p_letters, at
+  /// \p p_row and \p p_col, that are used by words in the other orientation
+  ///
+  /// \return -1 if the word does not fit, because it is out of the grid, or a
+  /// cell has another letter, or is used by a word in the same orientation
+  int crossings(const typ::letters &p_letters, typ::index p_row,
+                typ::index p_col, typ::orientation p_orientation) const {
+    const bool _vertical{p_orientation == typ::orientation::vert};
+    const typ::index _size{static_cast<typ::index>(p_letters.size())};
+    if ((p_row < 0) || (p_col < 0) ||
+        ((_vertical ? p_row : p_col) + _size >
+         (_vertical ? m_num_rows : m_num_cols)) ||
+        (_vertical ? (p_col >= m_num_cols) : (p_row >= m_num_rows))) {
+      return -1;
+    }
+    int _crossings{0};
+    for (typ::index _i = 0; _i < _size; ++_i) {
+      const size_t _cell{pos(_vertical ? p_row + _i : p_row,
+                             _vertical ? p_col : p_col + _i)};
+      if (m_letters[_cell] == empty_cell) {
+        continue;
+      }
+      if ((m_letters[_cell] != p_letters[static_cast<size_t>(_i)]) ||
+          ((_vertical ? m_vert : m_hori)[_cell] != 0)) {
+        return -1;
+      }
+      ++_crossings;
+    }
+    return _crossings;
+  }
+
+  void place(const typ::letters &p_letters, typ::index p_row, typ::index p_col,
+             typ::orientation p_orientation) {
+    const bool _vertical{p_orientation == typ::orientation::vert};
+    for (size_t _i = 0; _i < p_letters.size(); ++_i) {
+      const typ::index _offset{static_cast<typ::index>(_i)};
+      const size_t _cell{pos(_vertical ? p_row + _offset : p_row,
+                             _vertical ? p_col : p_col + _offset)};
+      m_letters[_cell] = p_letters[_i];
+      ++(_vertical ? m_vert : m_hori)[_cell];
+    }
+  }
+
+  void remove(const typ::letters &p_letters, typ::index p_row,
+              typ::index p_col, typ::orientation p_orientation) {
+    const bool _vertical{p_orientation == typ::orientation::vert};
+    for (size_t _i = 0; _i < p_letters.size(); ++_i) {
+      const typ::index _offset{static_cast<typ::index>(_i)};
+      const size_t _cell{pos(_vertical ? p_row + _offset : p_row,
+                             _vertical ? p_col : p_col + _offset)};
+      --(_vertical ? m_vert : m_hori)[_cell];
+      if ((m_vert[_cell] == 0) && (m_hori[_cell] == 0)) {
+        m_letters[_cell] = empty_cell;
+      }
+    }
+  }
+
+private:
+  inline size_t pos(typ::index p_row, typ::index p_col) const {
+    return static_cast<size_t>(p_row) * m_num_cols + p_col;
+  }
+
+private:
+  typ::index m_num_rows{0};
+  typ::index m_num_cols{0};
+  typ::letters m_letters;
+  std::vector<uint16_t> m_hori;
+  std::vector<uint16_t> m_vert;
+};
+
+} // namespace internal
+
+/// \brief Positions the words of a big set in a grid, organizing clusters
+/// of words in sub-grids, in parallel, and then placing the sub-grids in the
+/// grid
+///
+/// \details The permutations of all the words grow factorially, so, for
+/// many words, like 30 or more, this solves many small problems instead of a
+/// big one:
+/// - the words are partitioned with \p internal::cluster_words, in clusters
+///   of up to \p max_cluster_size words that share many letters
+/// - each cluster is organized by a \p t_organizer, in the smallest square
+///   sub-grid, from the size of its longest word, where it is organized,
+///   with the clusters distributed among the threads. The words of a cluster
+///   that could not be organized are placed one by one
+/// - the sub-grids, from the one with more words, are placed in the grid, in
+///   a depth first search where each sub-grid, maybe transposed, is placed
+///   where the letters at its borders cross the words already placed,
+///   preferring the places with more crossings. A sub-grid that fits nowhere
+///   is split in its words, which are placed one by one
+///
+/// All the words positioned are connected, as the words of a sub-grid are,
+/// and each sub-grid after the first crosses one placed before it.
+///
+/// \tparam t_grid type of grid, like \p typ::grid
+///
+/// \tparam t_organizer organizes the words of a cluster in a sub-grid, like
+/// \p internal::basic_restarting_organizer
+template <typename t_grid,
+          typename t_organizer = internal::basic_restarting_organizer<t_grid>>
+struct basic_clusterer {
+  /// \brief Default maximum number of words of a cluster
+  static constexpr size_t default_max_cluster_size{6};
+
+  /// \brief Default maximum number of sub-grids placed while placing the
+  /// sub-grids in the grid
+  static constexpr uint64_t default_max_stitches{100000};
+
+  /// \brief Constructor
+  ///
+  /// \param p_max_cluster_size maximum number of words of a cluster
+  ///
+  /// \param p_max_stitches maximum number of sub-grids placed, including the
+  /// ones removed by the backtracking, while placing the sub-grids in the
+  /// grid
+  basic_clusterer(size_t p_max_cluster_size = default_max_cluster_size,
+                  uint64_t p_max_stitches = default_max_stitches)
+      : m_max_cluster_size(std::max(p_max_cluster_size, size_t{1})),
+        m_max_stitches(p_max_stitches) {}
+
+  basic_clusterer(const basic_clusterer &) = delete;
+  basic_clusterer(basic_clusterer &&) = delete;
+  basic_clusterer &operator=(const basic_clusterer &) = delete;
+  basic_clusterer &operator=(basic_clusterer &&) = delete;
+  ~basic_clusterer() = default;
+
+  /// \brief Positions the words of \p p_entries in a grid
+  ///
+  /// \param p_entries entries used to assemble the grid
+  ///
+  /// \param p_num_rows number of rows of the grid
+  ///
+  /// \param p_num_cols number of columns of the grid
+  ///
+  /// \param p_num_threads number of threads that organize the clusters
+  ///
+  /// \return the grid with all the words positioned, or \p nullptr if the
+  /// sub-grids could not be placed in the grid
+  std::shared_ptr<t_grid>
+  start(const typ::entries &p_entries, typ::index p_num_rows,
+        typ::index p_num_cols,
+        size_t p_num_threads = std::max(std::thread::hardware_concurrency(),
+                                        1U)) {
+    m_stop = false;
+    m_stitches = 0;
+    m_splits = 0;
+    m_clusters.clear();
+    m_sub_grids.clear();
+    m_entries = p_entries;
+
+    typ::permutation _permutation;
+    for (typ::entries::const_entry_ite _entry = m_entries.begin();
+         _entry != m_entries.end(); ++_entry) {
+      _permutation.push_back(_entry);
+    }
+    if (_permutation.empty()) {
+      TNCT_LOG_ERR("no words to position");
+      return nullptr;
+    }
+
+    std::shared_ptr<t_grid> _grid;
+    try {
+      m_alphabet = std::make_shared<typ::alphabet>();
+      for (const typ::entry &_entry : m_entries) {
+        m_alphabet->add(_entry.get_word());
+      }
+      _grid = std::make_shared<t_grid>(_permutation, m_alphabet, p_num_rows,
+                                       p_num_cols);
+    } catch (std::exception &_ex) {
+      TNCT_LOG_ERR(_ex.what());
+      return nullptr;
+    }
+
+    const size_t _num_words{_permutation.size()};
+    m_letters.clear();
+    for (auto _layout = _grid->begin(); _layout != _grid->end(); ++_layout) {
+      m_letters.push_back(_layout->get_letters());
+    }
+    m_crossings.assign(_num_words * _num_words, 0);
+    for (size_t _i = 0; _i < _num_words; ++_i) {
+      for (size_t _j = _i + 1; _j < _num_words; ++_j) {
+        size_t _crossings{0};
+        internal::for_each_intersection(m_stop, m_letters[_i], m_letters[_j],
+                                        [&_crossings](const typ::coordinate &) {
+                                          ++_crossings;
+                                          return false;
+                                        });
+        m_crossings[_i * _num_words + _j] = _crossings;
+        m_crossings[_j * _num_words + _i] = _crossings;
+      }
+    }
+
+    m_clusters =
+        internal::cluster_words(m_crossings, _num_words, m_max_cluster_size);
+    TNCT_LOG_TRA("clusterer: ", m_clusters.size(), " clusters");
+
+    organize_clusters(std::min(std::max(p_num_threads, size_t{1}),
+                               m_clusters.size()),
+                      std::min(p_num_rows, p_num_cols));
+    if (m_stop) {
+      return nullptr;
+    }
+
+    m_singles.clear();
+    for (size_t _word = 0; _word < _num_words; ++_word) {
+      m_singles.push_back(
+          {{{_word, typ::index{0}, typ::index{0}, typ::orientation::hori}}});
+    }
+    std::vector<pending> _pending;
+    for (const internal::sub_grid &_sub_grid : m_sub_grids) {
+      _pending.push_back({&_sub_grid, false});
+    }
+
+    internal::stitch_board _board(p_num_rows, p_num_cols);
+    m_positions.assign(_num_words, absolute_position{});
+    m_num_placed = 0;
+    if (!stitch(_board, _pending, 0)) {
+      TNCT_LOG_TRA("clusterer: could not place the ", m_sub_grids.size(),
+                   " sub-grids after ", m_stitches, " placements");
+      return nullptr;
+    }
+
+    for (size_t _word = 0; _word < _num_words; ++_word) {
+      const absolute_position &_position{m_positions[_word]};
+      _grid->set(std::next(_grid->begin(), _word), _position.row,
+                 _position.col, _position.orientation);
+    }
+    return _grid;
+  }
+
+  /// \brief Stops organizing the clusters and placing the sub-grids
+  inline void stop() { m_stop = true; }
+
+  /// \brief Indexes of the words, in the order of the entries, of each
+  /// cluster of the last \p start
+  inline const std::vector<std::vector<size_t>> &get_clusters() const {
+    return m_clusters;
+  }
+
+  /// \brief Number of sub-grids placed in the last \p start, including the
+  /// ones removed by the backtracking
+  inline uint64_t get_num_stitches() const { return m_stitches; }
+
+  /// \brief Number of sub-grids of more than one word, in the last \p start,
+  /// that could not be placed as a whole, and were split in their words
+  inline uint64_t get_num_splits() const { return m_splits; }
+
+private:
+  /// \brief Where a sub-grid is placed in the grid
+  struct placement {
+    typ::index row{0};
+    typ::index col{0};
+    bool transposed{false};
+  };
+
+  /// \brief A sub-grid waiting to be placed
+  struct pending {
+    const internal::sub_grid *sub_grid{nullptr};
+
+    /// \brief If it was moved to the end because it did not cross the
+    /// sub-grids placed, which is done once
+    bool deferred{false};
+  };
+
+  /// \brief Where a word of a sub-grid is in the grid
+  struct absolute_position {
+    typ::index row{0};
+    typ::index col{0};
+    typ::orientation orientation{typ::orientation::undef};
+  };
+
+  /// \brief Where a sub-grid fits, with the number of cells it shares with
+  /// the words placed, and the distance of its center to the center of the
+  /// grid
+  struct candidate {
+    placement where;
+    int crossings{0};
+    int distance{0};
+  };
+
+private:
+  static absolute_position
+  absolute(const internal::sub_grid::position &p_position,
+           const placement &p_placement) {
+    if (!p_placement.transposed) {
+      return {static_cast<typ::index>(p_placement.row + p_position.row),
+              static_cast<typ::index>(p_placement.col + p_position.col),
+              p_position.orientation};
+    }
+    return {static_cast<typ::index>(p_placement.row + p_position.col),
+            static_cast<typ::index>(p_placement.col + p_position.row),
+            p_position.orientation == typ::orientation::hori
+                ? typ::orientation::vert
+                : typ::orientation::hori};
+  }
+
+  /// \brief Organizes each cluster in a sub-grid, with the clusters
+  /// distributed among \p p_num_threads threads
+  void organize_clusters(size_t p_num_threads, typ::index p_max_side) {
+    std::vector<std::vector<internal::sub_grid>> _sub_grids(
+        m_clusters.size());
+    std::atomic<size_t> _next{0};
+
+    std::vector<std::thread> _threads;
+    for (size_t _i = 0; _i < p_num_threads; ++_i) {
+      _threads.emplace_back([this, &_next, &_sub_grids, p_max_side]() {
+        for (size_t _cluster = _next++;
+             !m_stop && (_cluster < m_clusters.size()); _cluster = _next++) {
+          organize(m_clusters[_cluster], p_max_side, _sub_grids[_cluster]);
+        }
+      });
+    }
+    for (std::thread &_thread : _threads) {
+      _thread.join();
+    }
+
+    for (std::vector<internal::sub_grid> &_cluster_sub_grids : _sub_grids) {
+      for (internal::sub_grid &_sub_grid : _cluster_sub_grids) {
+        m_sub_grids.push_back(std::move(_sub_grid));
+      }
+    }
+    std::stable_sort(
+        m_sub_grids.begin(), m_sub_grids.end(),
+        [](const internal::sub_grid &p_s1, const internal::sub_grid &p_s2) {
+          return p_s1.positions.size() > p_s2.positions.size();
+        });
+  }
+
+  /// \brief Organizes the words of \p p_cluster in the smallest square
+  /// sub-grid possible, or in a sub-grid for each word, if it is not possible
+  void organize(const std::vector<size_t> &p_cluster, typ::index p_max_side,
+                std::vector<internal::sub_grid> &p_sub_grids) const {
+    if (p_cluster.size() > 1) {
+      // the word that shares more letters with the others, followed by the
+      // ones that share more letters with the words before them, so the
+      // first two words intersect
+      std::vector<size_t> _order;
+      std::vector<bool> _chosen(p_cluster.size(), false);
+      while (_order.size() < p_cluster.size()) {
+        size_t _best{p_cluster.size()};
+        size_t _best_crossings{0};
+        for (size_t _i = 0; _i < p_cluster.size(); ++_i) {
+          if (_chosen[_i]) {
+            continue;
+          }
+          size_t _crossings{0};
+          for (size_t _j = 0; _j < p_cluster.size(); ++_j) {
+            if ((_j != _i) && (_order.empty() || _chosen[_j])) {
+              _crossings += crossings(p_cluster[_i], p_cluster[_j]);
+            }
+          }
+          if ((_best == p_cluster.size()) || (_crossings > _best_crossings) ||
+              ((_crossings == _best_crossings) &&
+               (m_letters[p_cluster[_i]].size() >
+                m_letters[p_cluster[_best]].size()))) {
+            _best = _i;
+            _best_crossings = _crossings;
+          }
+        }
+        _chosen[_best] = true;
+        _order.push_back(p_cluster[_best]);
+      }
+
+      typ::permutation _permutation;
+      typ::index _longest{0};
+      for (size_t _word : _order) {
+        _permutation.push_back(std::next(m_entries.begin(), _word));
+        _longest = std::max(_longest,
+                            static_cast<typ::index>(m_letters[_word].size()));
+      }
+
+      for (typ::index _side = _longest; !m_stop && (_side <= p_max_side);
+           ++_side) {
+        auto _grid{std::make_shared<t_grid>(_permutation, m_alphabet, _side,
+                                            _side)};
+        t_organizer _organizer;
+        if (_organizer(_grid)) {
+          internal::sub_grid _sub_grid;
+          typ::index _min_row{_side};
+          typ::index _min_col{_side};
+          auto _layout{_grid->begin()};
+          for (size_t _word : _order) {
+            _sub_grid.positions.push_back({_word, _layout->get_row(),
+                                           _layout->get_col(),
+                                           _layout->get_orientation()});
+            _min_row = std::min(_min_row, _layout->get_row());
+            _min_col = std::min(_min_col, _layout->get_col());
+            ++_layout;
+          }
+          for (internal::sub_grid::position &_position : _sub_grid.positions) {
+            _position.row -= _min_row;
+            _position.col -= _min_col;
+          }
+          TNCT_LOG_TRA("clusterer: cluster of ", p_cluster.size(),
+                       " words organized in ", _side, 'x', _side);
+          p_sub_grids.push_back(std::move(_sub_grid));
+          return;
+        }
+      }
+      TNCT_LOG_TRA("clusterer: cluster of ", p_cluster.size(),
+                   " words not organized");
+    }
+
+    for (size_t _word : p_cluster) {
+      p_sub_grids.push_back(
+          {{{_word, typ::index{0}, typ::index{0}, typ::orientation::hori}}});
+    }
+  }
+
+  inline size_t crossings(size_t p_w1, size_t p_w2) const {
+    return m_crossings[p_w1 * m_letters.size() + p_w2];
+  }
+
+  /// \brief Places the sub-grid at \p p_next of \p p_pending, and the ones
+  /// after it
+  ///
+  /// \details A sub-grid of more than one word that fits nowhere is replaced
+  /// by a sub-grid for each one of its words, and a sub-grid of one word that
+  /// does not cross the words placed is moved to the end, once, as it may
+  /// cross the words placed after it
+  bool stitch(internal::stitch_board &p_board,
+              const std::vector<pending> &p_pending, size_t p_next) {
+    if (p_next == p_pending.size()) {
+      return true;
+    }
+
+    const internal::sub_grid &_sub_grid{*p_pending[p_next].sub_grid};
+    std::vector<candidate> _candidates;
+    candidates(p_board, _sub_grid, _candidates);
+
+    if (_candidates.empty()) {
+      if (_sub_grid.positions.size() > 1) {
+        ++m_splits;
+        std::vector<pending> _pending(p_pending.begin(),
+                                      std::next(p_pending.begin(), p_next));
+        for (const internal::sub_grid::position &_position :
+             _sub_grid.positions) {
+          _pending.push_back({&m_singles[_position.word], false});
+        }
+        _pending.insert(_pending.end(),
+                        std::next(p_pending.begin(), p_next + 1),
+                        p_pending.end());
+        return stitch(p_board, _pending, p_next);
+      }
+      if (!p_pending[p_next].deferred && (p_next + 1 < p_pending.size())) {
+        std::vector<pending> _pending(p_pending);
+        _pending.erase(std::next(_pending.begin(), p_next));
+        _pending.push_back({&_sub_grid, true});
+        return stitch(p_board, _pending, p_next);
+      }
+      return false;
+    }
+
+    for (const candidate &_candidate : _candidates) {
+      if (m_stop || (m_stitches >= m_max_stitches)) {
+        return false;
+      }
+      ++m_stitches;
+      for (const internal::sub_grid::position &_position :
+           _sub_grid.positions) {
+        const absolute_position _absolute{
+            absolute(_position, _candidate.where)};
+        p_board.place(m_letters[_position.word], _absolute.row, _absolute.col,
+                      _absolute.orientation);
+        m_positions[_position.word] = _absolute;
+      }
+      m_num_placed += _sub_grid.positions.size();
+      if (stitch(p_board, p_pending, p_next + 1)) {
+        return true;
+      }
+      m_num_placed -= _sub_grid.positions.size();
+      for (const internal::sub_grid::position &_position :
+           _sub_grid.positions) {
+        const absolute_position _absolute{
+            absolute(_position, _candidate.where)};
+        p_board.remove(m_letters[_position.word], _absolute.row,
+                       _absolute.col, _absolute.orientation);
+      }
+    }
+    return false;
+  }
+
+  /// \brief Fills \p p_candidates with the places where \p p_sub_grid, maybe
+  /// transposed, fits in \p p_board, crossing the words placed, if there are
+  /// words placed, from the ones with more crossings, and then from the ones
+  /// closer to the center
+  void candidates(const internal::stitch_board &p_board,
+                  const internal::sub_grid &p_sub_grid,
+                  std::vector<candidate> &p_candidates) const {
+    typ::index _num_rows{0};
+    typ::index _num_cols{0};
+    for (const internal::sub_grid::position &_position : p_sub_grid.positions) {
+      const typ::index _size{
+          static_cast<typ::index>(m_letters[_position.word].size())};
+      const bool _vertical{_position.orientation == typ::orientation::vert};
+      _num_rows = std::max(
+          _num_rows,
+          static_cast<typ::index>(_position.row + (_vertical ? _size : 1)));
+      _num_cols = std::max(
+          _num_cols,
+          static_cast<typ::index>(_position.col + (_vertical ? 1 : _size)));
+    }
+
+    p_candidates.clear();
+    for (bool _transposed : {false, true}) {
+      const typ::index _rows{_transposed ? _num_cols : _num_rows};
+      const typ::index _cols{_transposed ? _num_rows : _num_cols};
+      for (typ::index _row = 0; _row + _rows <= p_board.get_num_rows();
+           ++_row) {
+        for (typ::index _col = 0; _col + _cols <= p_board.get_num_cols();
+             ++_col) {
+          const placement _placement{_row, _col, _transposed};
+          int _crossings{0};
+          for (const internal::sub_grid::position &_position :
+               p_sub_grid.positions) {
+            const absolute_position _absolute{
+                absolute(_position, _placement)};
+            const int _word_crossings{
+                p_board.crossings(m_letters[_position.word], _absolute.row,
+                                  _absolute.col, _absolute.orientation)};
+            if (_word_crossings < 0) {
+              _crossings = -1;
+              break;
+            }
+            _crossings += _word_crossings;
+          }
+          if ((_crossings < 0) || ((m_num_placed != 0) && (_crossings == 0))) {
+            continue;
+          }
+          p_candidates.push_back(
+              {_placement, _crossings,
+               std::abs(2 * _row + _rows - p_board.get_num_rows()) +
+                   std::abs(2 * _col + _cols - p_board.get_num_cols())});
+        }
+      }
+    }
+    std::stable_sort(p_candidates.begin(), p_candidates.end(),
+                     [](const candidate &p_c1, const candidate &p_c2) {
+                       if (p_c1.crossings != p_c2.crossings) {
+                         return p_c1.crossings > p_c2.crossings;
+                       }
+                       return p_c1.distance < p_c2.distance;
+                     });
+  }
+
+private:
+  size_t m_max_cluster_size{default_max_cluster_size};
+  uint64_t m_max_stitches{default_max_stitches};
+  std::atomic<bool> m_stop{false};
+
+  typ::entries m_entries;
+  std::shared_ptr<typ::alphabet> m_alphabet;
+
+  /// \brief Letters of each word, in the order of the entries
+  std::vector<typ::letters> m_letters;
+
+  /// \brief Number of letters shared by each pair of words
+  std::vector<size_t> m_crossings;
+
+  std::vector<std::vector<size_t>> m_clusters;
+  std::vector<internal::sub_grid> m_sub_grids;
+
+  /// \brief A sub-grid for each word, used when a sub-grid is split
+  std::vector<internal::sub_grid> m_singles;
+
+  /// \brief Where each word was placed
+  std::vector<absolute_position> m_positions;
+  size_t m_num_placed{0};
+  uint64_t m_stitches{0};
+  uint64_t m_splits{0};
+};
+
+using clusterer = basic_clusterer<typ::grid>;
+
+} // namespace tenacitas::lib::crosswords::bus
+
+#endif
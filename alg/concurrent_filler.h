@@ -0,0 +1,490 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_ALG_CONCURRENT_FILLER_H
+#define TENACITAS_LIB_CROSSWORDS_ALG_CONCURRENT_FILLER_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <tenacitas.lib.crosswords/typ/grid.h>
+#include <tenacitas.lib.log/alg/logger.h>
+
+namespace tenacitas::lib::crosswords::bus {
+
+namespace internal {
+
+/// \brief Cells of a grid shared by threads that position words at the same
+/// time, where the cells of a word are claimed with compare and swap
+///
+/// \details Each cell is an atomic 32 bits number, with the letter in the 8
+/// lower bits, and the number of words that use the cell in the others, so
+/// a free cell is 0. A word claims its cells one by one: a free cell gets
+/// its letter, and a cell with the same letter gets one more use. If a cell
+/// has another letter, the cells already claimed are released, and the word
+/// is not positioned there. As the cells are claimed and released
+/// atomically, a word never sees a cell with a letter that was not set by a
+/// word, and two words never set different letters in a cell, without
+/// locks.
+///
+/// The cells are kept in tiles of \p tile_side x \p tile_side cells, and a
+/// tile is only allocated when one of its cells is claimed, also with
+/// compare and swap, so the memory of a big grid is proportional to the
+/// region used.
+struct claim_board {
+  static constexpr size_t tile_side{64};
+
+  claim_board(typ::index p_num_rows, typ::index p_num_cols)
+      : m_num_rows(p_num_rows), m_num_cols(p_num_cols),
+        m_tiles_per_row((static_cast<size_t>(p_num_cols) + tile_side - 1) /
+                        tile_side),
+        m_tiles(((static_cast<size_t>(p_num_rows) + tile_side - 1) /
+                 tile_side) *
+                m_tiles_per_row) {
+    for (std::atomic<tile *> &_tile : m_tiles) {
+      _tile.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  claim_board(const claim_board &) = delete;
+  claim_board(claim_board &&) = delete;
+  claim_board &operator=(const claim_board &) = delete;
+  claim_board &operator=(claim_board &&) = delete;
+
+  ~claim_board() {
+    for (std::atomic<tile *> &_tile : m_tiles) {
+      delete _tile.load(std::memory_order_relaxed);
+    }
+  }
+
+  inline typ::index get_num_rows() const { return m_num_rows; }
+  inline typ::index get_num_cols() const { return m_num_cols; }
+
+  /// \brief Number of tiles allocated
+  size_t get_num_tiles() const {
+    return static_cast<size_t>(
+        std::count_if(m_tiles.begin(), m_tiles.end(),
+                      [](const std::atomic<tile *> &p_tile) {
+                        return p_tile.load(std::memory_order_acquire) !=
+                               nullptr;
+                      }));
+  }
+
+  /// \brief Number of cells of the word of letters \p p_letters, at \p p_row
+  /// and \p p_col, that already have its letter, as the cells are now
+  ///
+  /// \return -1 if a cell has another letter
+  int overlaps(const typ::letters &p_letters, typ::index p_row,
+               typ::index p_col, typ::orientation p_orientation) const {
+    const typ::index _row_step{typ::row_step(p_orientation)};
+    const typ::index _col_step{typ::col_step(p_orientation)};
+    int _overlaps{0};
+    for (size_t _i = 0; _i < p_letters.size(); ++_i) {
+      const uint32_t _cell{read(step(p_row, _i, _row_step),
+                                step(p_col, _i, _col_step))};
+      if (_cell == 0) {
+        continue;
+      }
+      if (letter(_cell) != p_letters[_i]) {
+        return -1;
+      }
+      ++_overlaps;
+    }
+    return _overlaps;
+  }
+
+  /// \brief Claims the cells of the word of letters \p p_letters, at
+  /// \p p_row and \p p_col
+  ///
+  /// \return \p false if a cell has another letter, or if all the cells were
+  /// already used, as the word would be inside another one; the cells
+  /// claimed are then released
+  bool claim(const typ::letters &p_letters, typ::index p_row,
+             typ::index p_col, typ::orientation p_orientation) {
+    const typ::index _row_step{typ::row_step(p_orientation)};
+    const typ::index _col_step{typ::col_step(p_orientation)};
+    bool _new_cell{false};
+    for (size_t _i = 0; _i < p_letters.size(); ++_i) {
+      std::atomic<uint32_t> &_cell{cell(step(p_row, _i, _row_step),
+                                        step(p_col, _i, _col_step))};
+      const uint32_t _letter{static_cast<uint8_t>(p_letters[_i])};
+      uint32_t _current{_cell.load(std::memory_order_acquire)};
+      while (true) {
+        if ((_current != 0) && (letter(_current) != p_letters[_i])) {
+          release(p_row, p_col, p_orientation, _i);
+          return false;
+        }
+        const uint32_t _desired{(_current == 0) ? (_letter | one_use)
+                                                : (_current + one_use)};
+        if (_cell.compare_exchange_weak(_current, _desired,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+          _new_cell = _new_cell || (_current == 0);
+          break;
+        }
+      }
+    }
+    if (!_new_cell) {
+      release(p_row, p_col, p_orientation, p_letters.size());
+      return false;
+    }
+    return true;
+  }
+
+private:
+  using tile = std::array<std::atomic<uint32_t>, tile_side * tile_side>;
+
+  static constexpr uint32_t one_use{uint32_t{1} << 8};
+
+  static inline typ::letter letter(uint32_t p_cell) {
+    return static_cast<typ::letter>(static_cast<uint8_t>(p_cell & 0xFF));
+  }
+
+  /// \brief Row, or column, of the letter \p p_offset of a word that starts
+  /// at \p p_first, and moves \p p_step from a letter to the next
+  static inline typ::index step(typ::index p_first, size_t p_offset,
+                                typ::index p_step) {
+    return p_first + static_cast<typ::index>(p_offset) * p_step;
+  }
+
+  inline size_t tile_pos(typ::index p_row, typ::index p_col) const {
+    return (static_cast<size_t>(p_row) / tile_side) * m_tiles_per_row +
+           static_cast<size_t>(p_col) / tile_side;
+  }
+
+  static inline size_t cell_pos(typ::index p_row, typ::index p_col) {
+    return (static_cast<size_t>(p_row) % tile_side) * tile_side +
+           static_cast<size_t>(p_col) % tile_side;
+  }
+
+  /// \brief Value of a cell, where the cells of a tile not allocated are 0
+  inline uint32_t read(typ::index p_row, typ::index p_col) const {
+    const tile *_tile{
+        m_tiles[tile_pos(p_row, p_col)].load(std::memory_order_acquire)};
+    return _tile ? (*_tile)[cell_pos(p_row, p_col)].load(
+                       std::memory_order_acquire)
+                 : 0;
+  }
+
+  /// \brief A cell, allocating its tile if it is not allocated
+  std::atomic<uint32_t> &cell(typ::index p_row, typ::index p_col) {
+    std::atomic<tile *> &_slot{m_tiles[tile_pos(p_row, p_col)]};
+    tile *_tile{_slot.load(std::memory_order_acquire)};
+    if (!_tile) {
+      // if another worker allocates the tile first, its tile is used
+      tile *_new{new tile{}};
+      if (_slot.compare_exchange_strong(_tile, _new,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+        _tile = _new;
+      } else {
+        delete _new;
+      }
+    }
+    return (*_tile)[cell_pos(p_row, p_col)];
+  }
+
+  /// \brief Releases the first \p p_num_cells cells of a word
+  void release(typ::index p_row, typ::index p_col,
+               typ::orientation p_orientation, size_t p_num_cells) {
+    const typ::index _row_step{typ::row_step(p_orientation)};
+    const typ::index _col_step{typ::col_step(p_orientation)};
+    for (size_t _i = 0; _i < p_num_cells; ++_i) {
+      std::atomic<uint32_t> &_cell{cell(step(p_row, _i, _row_step),
+                                        step(p_col, _i, _col_step))};
+      uint32_t _current{_cell.load(std::memory_order_acquire)};
+      while (!_cell.compare_exchange_weak(
+          _current, ((_current >> 8) == 1) ? 0 : (_current - one_use),
+          std::memory_order_acq_rel, std::memory_order_acquire)) {
+      }
+    }
+  }
+
+private:
+  typ::index m_num_rows{0};
+  typ::index m_num_cols{0};
+  size_t m_tiles_per_row{0};
+  std::vector<std::atomic<tile *>> m_tiles;
+};
+
+} // namespace internal
+
+/// \brief Positions the words of a big set in a large grid, like a word
+/// search puzzle, with threads positioning words in the same grid at the
+/// same time
+///
+/// \details The rows of the grid are divided in a band for each worker, and
+/// each worker takes the next word, from the longest, and tries to position
+/// it starting in its band, claiming the cells in an
+/// \p internal::claim_board. A word can cross the words positioned by any
+/// worker, and when another worker changes a cell first, the claim fails,
+/// the cells are released, and the worker tries another place, so the
+/// workers only wait for each other when they claim the same cell.
+///
+/// For each claim, \p samples_per_claim random places are read, and the one
+/// where the word shares more cells with the words positioned, without being
+/// inside one of them, is claimed, so the grid gets dense. When the band of
+/// the worker is full, after half of \p p_max_tries places read, the word
+/// can start in any row, and it is given up after \p p_max_tries places
+/// read.
+///
+/// The words do not have to cross each other, so the grid returned is not a
+/// crossword, and may not have all the words positioned. The orientations
+/// of the words are chosen at random among the ones given, like the 8
+/// orientations in \p typ::all_orientations for a word search puzzle.
+///
+/// \tparam t_grid type of grid, like \p typ::grid
+template <typename t_grid> struct basic_concurrent_filler {
+  /// \brief Default maximum number of places read for a word
+  static constexpr size_t default_max_tries{512};
+
+  /// \brief Number of places read before each claim
+  static constexpr size_t samples_per_claim{8};
+
+  /// \brief Constructor
+  ///
+  /// \param p_max_tries maximum number of places read for a word
+  ///
+  /// \param p_orientations orientations the words can have, where
+  /// \p typ::orientation::undef is ignored, and \p typ::orientation::hori and
+  /// \p typ::orientation::vert are used if none is left
+  basic_concurrent_filler(
+      size_t p_max_tries = default_max_tries,
+      const std::vector<typ::orientation> &p_orientations = {
+          typ::crosswords_orientations.begin(),
+          typ::crosswords_orientations.end()})
+      : m_max_tries(std::max(p_max_tries, size_t{1})) {
+    std::copy_if(p_orientations.begin(), p_orientations.end(),
+                 std::back_inserter(m_orientations),
+                 [](typ::orientation p_orientation) {
+                   return p_orientation != typ::orientation::undef;
+                 });
+    if (m_orientations.empty()) {
+      m_orientations.assign(typ::crosswords_orientations.begin(),
+                            typ::crosswords_orientations.end());
+    }
+  }
+
+  basic_concurrent_filler(const basic_concurrent_filler &) = delete;
+  basic_concurrent_filler(basic_concurrent_filler &&) = delete;
+  basic_concurrent_filler &operator=(const basic_concurrent_filler &) = delete;
+  basic_concurrent_filler &operator=(basic_concurrent_filler &&) = delete;
+  ~basic_concurrent_filler() = default;
+
+  /// \brief Positions the words of \p p_entries in a grid
+  ///
+  /// \param p_entries entries used to fill the grid
+  ///
+  /// \param p_num_rows number of rows of the grid
+  ///
+  /// \param p_num_cols number of columns of the grid
+  ///
+  /// \param p_num_workers number of threads positioning words
+  ///
+  /// \param p_seed seed of the first worker, and the others are derived
+  /// from it
+  ///
+  /// \return the grid with the words positioned, or \p nullptr if it was
+  /// not possible to create the grid
+  std::shared_ptr<t_grid>
+  start(const typ::entries &p_entries, typ::index p_num_rows,
+        typ::index p_num_cols,
+        size_t p_num_workers = std::max(std::thread::hardware_concurrency(),
+                                        1U),
+        uint64_t p_seed = 0) {
+    m_stop = false;
+    m_conflicts = 0;
+    m_entries = p_entries;
+
+    typ::permutation _permutation;
+    for (typ::entries::const_entry_ite _entry = m_entries.begin();
+         _entry != m_entries.end(); ++_entry) {
+      _permutation.push_back(_entry);
+    }
+    if (_permutation.empty()) {
+      TNCT_LOG_ERR("no words to position");
+      return nullptr;
+    }
+
+    std::shared_ptr<t_grid> _grid;
+    try {
+      _grid = std::make_shared<t_grid>(_permutation, p_num_rows, p_num_cols);
+    } catch (std::exception &_ex) {
+      TNCT_LOG_ERR(_ex.what());
+      return nullptr;
+    }
+
+    // longest words first, as they have less places
+    m_order.clear();
+    for (auto _layout = _grid->begin(); _layout != _grid->end(); ++_layout) {
+      m_order.push_back(_layout);
+    }
+    std::stable_sort(m_order.begin(), m_order.end(),
+                     [](layout_ite p_l1, layout_ite p_l2) {
+                       return p_l1->get_size() > p_l2->get_size();
+                     });
+    m_places.assign(m_order.size(), place{});
+
+    const size_t _num_workers{std::min(
+        std::max(p_num_workers, size_t{1}), static_cast<size_t>(p_num_rows))};
+    internal::claim_board _board(p_num_rows, p_num_cols);
+    std::atomic<size_t> _next{0};
+    std::vector<std::thread> _threads;
+    for (size_t _worker = 0; _worker < _num_workers; ++_worker) {
+      const typ::index _first_row{static_cast<typ::index>(
+          (static_cast<size_t>(p_num_rows) * _worker) / _num_workers)};
+      const typ::index _last_row{static_cast<typ::index>(
+          (static_cast<size_t>(p_num_rows) * (_worker + 1)) / _num_workers)};
+      _threads.emplace_back([this, &_board, &_next, _first_row, _last_row,
+                             _seed = typ::mix(p_seed + _worker)]() {
+        work(_board, _next, _first_row, _last_row, _seed);
+      });
+    }
+    for (std::thread &_thread : _threads) {
+      _thread.join();
+    }
+
+    m_num_placed = 0;
+    for (size_t _word = 0; _word < m_order.size(); ++_word) {
+      const place &_place{m_places[_word]};
+      if (_place.orientation != typ::orientation::undef) {
+        _grid->set(m_order[_word], _place.row, _place.col, _place.orientation);
+        ++m_num_placed;
+      }
+    }
+    TNCT_LOG_TRA("concurrent filler: ", m_num_placed, " of ", m_order.size(),
+                 " words positioned, with ", m_conflicts.load(),
+                 " claims failed");
+    return _grid;
+  }
+
+  /// \brief Stops the workers
+  inline void stop() { m_stop = true; }
+
+  /// \brief Number of words positioned in the last \p start
+  inline size_t get_num_placed() const { return m_num_placed; }
+
+  /// \brief Number of claims that failed in the last \p start, because
+  /// another worker changed a cell between reading and claiming it
+  inline uint64_t get_num_conflicts() const { return m_conflicts; }
+
+private:
+  using layout_ite = typename t_grid::layout_ite;
+
+  struct place {
+    typ::index row{0};
+    typ::index col{0};
+    typ::orientation orientation{typ::orientation::undef};
+  };
+
+private:
+  /// \brief Positions the next word not taken by another worker, starting
+  /// at a row from \p p_first_row to \p p_last_row, exclusive, if possible
+  void work(internal::claim_board &p_board, std::atomic<size_t> &p_next,
+            typ::index p_first_row, typ::index p_last_row, uint64_t p_seed) {
+    std::mt19937_64 _random(p_seed);
+    for (size_t _word = p_next++; !m_stop && (_word < m_order.size());
+         _word = p_next++) {
+      const typ::letters &_letters{m_order[_word]->get_letters()};
+      const typ::index _size{m_order[_word]->get_size()};
+
+      size_t _tries{0};
+      while (!m_stop && (_tries < m_max_tries)) {
+        place _best;
+        int _best_overlaps{-1};
+        for (size_t _sample = 0;
+             (_sample < samples_per_claim) && (_tries < m_max_tries);
+             ++_sample, ++_tries) {
+          // the second half of the tries is in any row
+          const bool _in_band{_tries < m_max_tries / 2};
+          place _place;
+          if (!sample(p_board, _size, _in_band ? p_first_row : typ::index{0},
+                      _in_band ? p_last_row : p_board.get_num_rows(), _random,
+                      _place)) {
+            continue;
+          }
+          const int _overlaps{p_board.overlaps(_letters, _place.row,
+                                               _place.col, _place.orientation)};
+          if ((_overlaps > _best_overlaps) && (_overlaps < _size)) {
+            _best = _place;
+            _best_overlaps = _overlaps;
+          }
+        }
+        if (_best_overlaps < 0) {
+          continue;
+        }
+        if (p_board.claim(_letters, _best.row, _best.col, _best.orientation)) {
+          m_places[_word] = _best;
+          break;
+        }
+        ++m_conflicts;
+      }
+    }
+  }
+
+  /// \brief Random place where a word of \p p_size letters starts in a row
+  /// from \p p_first_row to \p p_last_row, exclusive, and fits in the grid
+  ///
+  /// \details A word going up must start at least \p p_size - 1 rows from
+  /// the top, and a word going down at least \p p_size - 1 rows from the
+  /// bottom, and likewise for the columns
+  ///
+  /// \return \p false if there is no such place in the orientation chosen
+  bool sample(const internal::claim_board &p_board, typ::index p_size,
+              typ::index p_first_row, typ::index p_last_row,
+              std::mt19937_64 &p_random, place &p_place) const {
+    p_place.orientation = m_orientations[p_random() % m_orientations.size()];
+    const typ::index _row_step{typ::row_step(p_place.orientation)};
+    const typ::index _col_step{typ::col_step(p_place.orientation)};
+
+    const typ::index _first_row{
+        std::max(p_first_row, (_row_step < 0) ? p_size - 1 : 0)};
+    const typ::index _last_row{std::min(
+        p_last_row, (_row_step > 0) ? p_board.get_num_rows() - p_size + 1
+                                    : p_board.get_num_rows())};
+    const typ::index _first_col{(_col_step < 0) ? p_size - 1 : 0};
+    const typ::index _last_col{(_col_step > 0)
+                                   ? p_board.get_num_cols() - p_size + 1
+                                   : p_board.get_num_cols()};
+    if ((_last_row <= _first_row) || (_last_col <= _first_col)) {
+      return false;
+    }
+    p_place.row = static_cast<typ::index>(
+        _first_row + (p_random() % static_cast<uint64_t>(_last_row -
+                                                         _first_row)));
+    p_place.col = static_cast<typ::index>(
+        _first_col + (p_random() % static_cast<uint64_t>(_last_col -
+                                                         _first_col)));
+    return true;
+  }
+
+private:
+  size_t m_max_tries{default_max_tries};
+  std::vector<typ::orientation> m_orientations;
+  std::atomic<bool> m_stop{false};
+  std::atomic<uint64_t> m_conflicts{0};
+  typ::entries m_entries;
+
+  /// \brief Words of the grid, from the longest
+  std::vector<layout_ite> m_order;
+
+  /// \brief Where each word of \p m_order was positioned, written only by
+  /// the worker that took it
+  std::vector<place> m_places;
+  size_t m_num_placed{0};
+};
+
+using concurrent_filler = basic_concurrent_filler<typ::grid>;
+
+} // namespace tenacitas::lib::crosswords::bus
+
+#endif
@@ -0,0 +1,400 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_ALG_PORTFOLIO_H
+#define TENACITAS_LIB_CROSSWORDS_ALG_PORTFOLIO_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <tenacitas.lib.async/alg/dispatcher.h>
+#include <tenacitas.lib.crosswords/alg/annealer.h>
+#include <tenacitas.lib.crosswords/alg/assembler.h>
+#include <tenacitas.lib.crosswords/alg/backtracking_organizer.h>
+#include <tenacitas.lib.crosswords/alg/beam_searcher.h>
+#include <tenacitas.lib.crosswords/typ/grid.h>
+#include <tenacitas.lib.log/alg/logger.h>
+
+namespace tenacitas::lib::crosswords::bus {
+
+namespace internal {
+
+/// \brief Runs a solver created for each round, so it can be stopped from
+/// another thread while it runs
+///
+/// \tparam t_solver type of the solver, that has a \p stop method
+template <typename t_solver> struct stoppable {
+  /// \brief Creates a solver, unless stopped, and calls \p p_function with it
+  template <typename t_grid, typename t_create, typename t_function>
+  std::shared_ptr<t_grid> operator()(t_create p_create,
+                                     t_function p_function) {
+    {
+      std::lock_guard<std::mutex> _lock{m_mutex};
+      if (m_stop) {
+        return nullptr;
+      }
+      m_solver = p_create();
+    }
+    std::shared_ptr<t_grid> _grid{p_function(*m_solver)};
+    std::lock_guard<std::mutex> _lock{m_mutex};
+    m_solver.reset();
+    return _grid;
+  }
+
+  void stop() {
+    std::lock_guard<std::mutex> _lock{m_mutex};
+    m_stop = true;
+    if (m_solver) {
+      m_solver->stop();
+    }
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> _lock{m_mutex};
+    m_stop = false;
+  }
+
+private:
+  std::mutex m_mutex;
+  bool m_stop{false};
+  std::unique_ptr<t_solver> m_solver;
+};
+
+/// \brief Number of words positioned in a grid
+template <typename t_grid> size_t num_positioned(const t_grid &p_grid) {
+  return static_cast<size_t>(std::count_if(
+      p_grid.begin(), p_grid.end(),
+      [](const typ::layout &p_layout) { return p_layout.is_positioned(); }));
+}
+
+/// \brief Splits \p p_num_threads among solvers, proportionally to their
+/// weights, and with at least one thread for each solver
+template <size_t t_num_solvers>
+std::array<size_t, t_num_solvers>
+shares(const std::array<double, t_num_solvers> &p_weights,
+       size_t p_num_threads) {
+  std::array<size_t, t_num_solvers> _shares;
+  _shares.fill(1);
+  if (p_num_threads <= t_num_solvers) {
+    return _shares;
+  }
+
+  double _total{0};
+  for (double _weight : p_weights) {
+    _total += _weight;
+  }
+  const size_t _spare{p_num_threads - t_num_solvers};
+
+  // largest remainder, so all the spare threads are given
+  std::array<double, t_num_solvers> _remainders;
+  size_t _given{0};
+  for (size_t _i = 0; _i < t_num_solvers; ++_i) {
+    const double _exact{static_cast<double>(_spare) * p_weights[_i] / _total};
+    const size_t _whole{static_cast<size_t>(_exact)};
+    _shares[_i] += _whole;
+    _given += _whole;
+    _remainders[_i] = _exact - static_cast<double>(_whole);
+  }
+  while (_given < _spare) {
+    const size_t _largest{static_cast<size_t>(
+        std::max_element(_remainders.begin(), _remainders.end()) -
+        _remainders.begin())};
+    ++_shares[_largest];
+    _remainders[_largest] = -1;
+    ++_given;
+  }
+  return _shares;
+}
+
+} // namespace internal
+
+/// \brief Solver of \p basic_portfolio that runs a \p basic_assembler, with
+/// \p p_unit times 2 to the round maximum tries
+template <typename t_grid,
+          typename t_organizer = internal::basic_organizer<t_grid>,
+          typename t_permutations = lexicographic_permutations>
+struct assembler_solver {
+  using assembler = basic_assembler<t_grid, t_organizer, t_permutations>;
+
+  static constexpr uint64_t default_unit{1000};
+
+  assembler_solver(uint64_t p_unit = default_unit) : m_unit(p_unit) {}
+
+  std::shared_ptr<t_grid> operator()(const typ::entries &p_entries,
+                                     typ::index p_num_rows,
+                                     typ::index p_num_cols,
+                                     size_t p_num_threads, size_t p_round) {
+    return m_stoppable.template operator()<t_grid>(
+        []() {
+          return std::make_unique<assembler>(async::alg::dispatcher::create());
+        },
+        [&](assembler &p_assembler) {
+          return p_assembler.start(p_entries, p_num_rows, p_num_cols,
+                                   p_num_threads, m_unit << p_round);
+        });
+  }
+
+  inline void stop() { m_stoppable.stop(); }
+  inline void reset() { m_stoppable.reset(); }
+
+private:
+  uint64_t m_unit{default_unit};
+  internal::stoppable<assembler> m_stoppable;
+};
+
+/// \brief Solver of \p basic_portfolio that runs a \p basic_annealer, with
+/// \p p_unit times 2 to the round steps for each chain, and the round as
+/// seed
+template <typename t_grid, typename t_schedule = exponential_cooling>
+struct annealer_solver {
+  using annealer = basic_annealer<t_grid, t_schedule>;
+
+  static constexpr uint64_t default_unit{20000};
+
+  annealer_solver(uint64_t p_unit = default_unit) : m_unit(p_unit) {}
+
+  std::shared_ptr<t_grid> operator()(const typ::entries &p_entries,
+                                     typ::index p_num_rows,
+                                     typ::index p_num_cols,
+                                     size_t p_num_threads, size_t p_round) {
+    return m_stoppable.template operator()<t_grid>(
+        [&]() { return std::make_unique<annealer>(m_unit << p_round); },
+        [&](annealer &p_annealer) {
+          return p_annealer.start(p_entries, p_num_rows, p_num_cols,
+                                  p_num_threads, p_round);
+        });
+  }
+
+  inline void stop() { m_stoppable.stop(); }
+  inline void reset() { m_stoppable.reset(); }
+
+private:
+  uint64_t m_unit{default_unit};
+  internal::stoppable<annealer> m_stoppable;
+};
+
+/// \brief Solver of \p basic_portfolio that runs a \p basic_beam_searcher,
+/// keeping \p p_unit times 2 to the round grids at each depth
+template <typename t_grid, typename t_heuristic = flexibility_heuristic>
+struct beam_solver {
+  using beam_searcher = basic_beam_searcher<t_grid, t_heuristic>;
+
+  static constexpr size_t default_unit{16};
+
+  beam_solver(size_t p_unit = default_unit) : m_unit(p_unit) {}
+
+  std::shared_ptr<t_grid> operator()(const typ::entries &p_entries,
+                                     typ::index p_num_rows,
+                                     typ::index p_num_cols,
+                                     size_t p_num_threads, size_t p_round) {
+    return m_stoppable.template operator()<t_grid>(
+        []() { return std::make_unique<beam_searcher>(); },
+        [&](beam_searcher &p_beam_searcher) {
+          return p_beam_searcher.start(p_entries, p_num_rows, p_num_cols,
+                                       m_unit << p_round, p_num_threads);
+        });
+  }
+
+  inline void stop() { m_stoppable.stop(); }
+  inline void reset() { m_stoppable.reset(); }
+
+private:
+  size_t m_unit{default_unit};
+  internal::stoppable<beam_searcher> m_stoppable;
+};
+
+/// \brief Runs several solvers at the same time, sharing a number of
+/// threads, and returns the first grid organized
+///
+/// \details No solver is the best for all the inputs, so the time to
+/// organize a grid is, at worst, the time of the best solver for that input
+/// with its share of the threads.
+///
+/// The solvers run in rounds, and each round doubles their effort, like the
+/// maximum tries of an assembler or the steps of an annealer. In the first
+/// round, the threads are split evenly. In the next rounds, each solver gets
+/// at least one thread, and the others are split proportionally to 1 plus
+/// the number of words positioned in the best grid it returned so far, so a
+/// solver that is closer to an organization gets more threads.
+///
+/// When a solver organizes a grid, the others are stopped, and it is
+/// returned. If no solver organizes it after all the rounds, the grid with
+/// more words positioned is returned.
+///
+/// \tparam t_grid type of grid, like \p typ::grid, or \p typ::fixed_grid
+///
+/// \tparam t_solvers solvers, like \p assembler_solver, \p annealer_solver or
+/// \p beam_solver, each one with a call operator that receives the entries,
+/// the number of rows and columns, the number of threads and the round, and a
+/// \p stop and a \p reset method
+template <typename t_grid, typename... t_solvers> struct basic_portfolio {
+  static constexpr size_t num_solvers{sizeof...(t_solvers)};
+  static_assert(num_solvers > 0, "a portfolio needs at least one solver");
+
+  /// \brief Default number of rounds
+  static constexpr size_t default_num_rounds{4};
+
+  basic_portfolio() = default;
+  basic_portfolio(const basic_portfolio &) = delete;
+  basic_portfolio(basic_portfolio &&) = delete;
+  basic_portfolio &operator=(const basic_portfolio &) = delete;
+  basic_portfolio &operator=(basic_portfolio &&) = delete;
+  ~basic_portfolio() = default;
+
+  /// \brief Tries to organize a grid with all the solvers
+  ///
+  /// \param p_entries entries used to assemble the grid
+  ///
+  /// \param p_num_rows number of rows of the grid
+  ///
+  /// \param p_num_cols number of columns of the grid
+  ///
+  /// \param p_num_threads number of threads shared by the solvers
+  ///
+  /// \param p_num_rounds maximum number of rounds
+  ///
+  /// \return the first grid organized, or the one with more words
+  /// positioned, or \p nullptr if no solver returned a grid
+  std::shared_ptr<t_grid>
+  start(const typ::entries &p_entries, typ::index p_num_rows,
+        typ::index p_num_cols,
+        size_t p_num_threads = std::max(std::thread::hardware_concurrency(),
+                                        1U),
+        size_t p_num_rounds = default_num_rounds) {
+    m_stop = false;
+    m_solved = false;
+    m_winner = num_solvers;
+    m_best.fill(0);
+    for_each([](auto &p_solver, size_t) { p_solver.reset(); });
+
+    const size_t _num_words{
+        static_cast<size_t>(p_entries.get_num_entries())};
+    std::shared_ptr<t_grid> _best;
+    size_t _best_positioned{0};
+
+    for (m_round = 0; (m_round < p_num_rounds) && !m_stop; ++m_round) {
+      std::array<double, num_solvers> _weights;
+      for (size_t _i = 0; _i < num_solvers; ++_i) {
+        _weights[_i] = 1.0 + static_cast<double>(m_best[_i]);
+      }
+      m_shares = internal::shares(_weights, p_num_threads);
+
+      std::array<std::shared_ptr<t_grid>, num_solvers> _grids;
+      std::array<std::atomic<bool>, num_solvers> _finished;
+      std::vector<std::thread> _threads;
+      for_each([&](auto &p_solver, size_t p_i) {
+        _finished[p_i] = false;
+        _threads.emplace_back([&, p_i]() {
+          _grids[p_i] = p_solver(p_entries, p_num_rows, p_num_cols,
+                                 m_shares[p_i], m_round);
+          if (_grids[p_i] && _grids[p_i]->organized() &&
+              !m_solved.exchange(true)) {
+            m_winner = p_i;
+          }
+          _finished[p_i] = true;
+        });
+      });
+
+      // stops the solvers still running once a grid is organized, until
+      // they finish, as a solver can be stopped before it starts
+      while (!std::all_of(_finished.begin(), _finished.end(),
+                          [](const std::atomic<bool> &p_finished) {
+                            return p_finished.load();
+                          })) {
+        if (m_solved || m_stop) {
+          for_each([&](auto &p_solver, size_t p_i) {
+            if (!_finished[p_i]) {
+              p_solver.stop();
+            }
+          });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      for (std::thread &_thread : _threads) {
+        _thread.join();
+      }
+
+      if (m_solved) {
+        TNCT_LOG_TRA("portfolio: solver ", m_winner,
+                     " organized the grid in round ", m_round);
+        return _grids[m_winner];
+      }
+
+      for (size_t _i = 0; _i < num_solvers; ++_i) {
+        if (!_grids[_i]) {
+          continue;
+        }
+        const size_t _positioned{internal::num_positioned(*_grids[_i])};
+        m_best[_i] = std::max(m_best[_i], _positioned);
+        if (!_best || (_positioned > _best_positioned)) {
+          _best = _grids[_i];
+          _best_positioned = _positioned;
+        }
+      }
+      TNCT_LOG_TRA("portfolio: after round ", m_round, ", best grid has ",
+                   _best_positioned, " of ", _num_words, " words");
+    }
+    return _best;
+  }
+
+  /// \brief Stops all the solvers
+  inline void stop() { m_stop = true; }
+
+  /// \brief Index of the solver that organized the grid, or \p num_solvers
+  /// if none did
+  inline size_t get_winner() const { return m_winner; }
+
+  /// \brief Number of rounds run in the last \p start
+  inline size_t get_num_rounds() const { return m_round; }
+
+  /// \brief Number of threads of each solver in the last round
+  inline const std::array<size_t, num_solvers> &get_shares() const {
+    return m_shares;
+  }
+
+  /// \brief A solver, for its configuration
+  template <size_t t_index> inline auto &get() {
+    return std::get<t_index>(m_solvers);
+  }
+
+private:
+  template <typename t_function> void for_each(t_function p_function) {
+    for_each(p_function, std::index_sequence_for<t_solvers...>{});
+  }
+
+  template <typename t_function, size_t... t_indexes>
+  void for_each(t_function &p_function, std::index_sequence<t_indexes...>) {
+    (p_function(std::get<t_indexes>(m_solvers), t_indexes), ...);
+  }
+
+private:
+  std::tuple<t_solvers...> m_solvers;
+  std::atomic<bool> m_stop{false};
+  std::atomic<bool> m_solved{false};
+  std::atomic<size_t> m_winner{num_solvers};
+  size_t m_round{0};
+  std::array<size_t, num_solvers> m_shares{};
+  std::array<size_t, num_solvers> m_best{};
+};
+
+/// \brief Portfolio with permutation enumeration, randomized depth first
+/// search with restarts, beam search and simulated annealing
+using portfolio = basic_portfolio<
+    typ::grid, assembler_solver<typ::grid>,
+    assembler_solver<typ::grid, internal::restarting_organizer>,
+    beam_solver<typ::grid>, annealer_solver<typ::grid>>;
+
+} // namespace tenacitas::lib::crosswords::bus
+
+#endif
@@ -10,6 +10,16 @@ DISTFILES += \
     $$BASE_DIR/tenacitas.lib.crosswords/README.md
 
 HEADERS +=  \
+    $$BASE_DIR/tenacitas.lib.crosswords/alg/annealer.h \
     $$BASE_DIR/tenacitas.lib.crosswords/alg/assembler.h \
+    $$BASE_DIR/tenacitas.lib.crosswords/alg/backtracking_organizer.h \
+    $$BASE_DIR/tenacitas.lib.crosswords/alg/beam_searcher.h \
+    $$BASE_DIR/tenacitas.lib.crosswords/alg/clusterer.h \
+    $$BASE_DIR/tenacitas.lib.crosswords/alg/concurrent_filler.h \
+    $$BASE_DIR/tenacitas.lib.crosswords/alg/portfolio.h \
     $$BASE_DIR/tenacitas.lib.crosswords/evt/events.h \
-    $$BASE_DIR/tenacitas.lib.crosswords/typ/grid.h
+    $$BASE_DIR/tenacitas.lib.crosswords/typ/alphabet.h \
+    $$BASE_DIR/tenacitas.lib.crosswords/typ/grid.h \
+    $$BASE_DIR/tenacitas.lib.crosswords/typ/nogood_store.h \
+    $$BASE_DIR/tenacitas.lib.crosswords/typ/simd.h \
+    $$BASE_DIR/tenacitas.lib.crosswords/typ/transposition_table.h
@@ -15,27 +15,33 @@
 namespace tenacitas::lib::crosswords::evt {
 
 /// \brief Published when a new grid be assembled
-struct new_grid_to_organize {
-  new_grid_to_organize() = default;
-  explicit new_grid_to_organize(std::shared_ptr<typ::grid> p_grid)
+///
+/// \tparam t_grid type of grid, like \p typ::grid or \p typ::fixed_grid
+template <typename t_grid> struct basic_new_grid_to_organize {
+  basic_new_grid_to_organize() = default;
+  explicit basic_new_grid_to_organize(std::shared_ptr<t_grid> p_grid)
       : grid(p_grid) {}
 
   friend std::ostream &operator<<(std::ostream &p_out,
-                                  const new_grid_to_organize &) {
+                                  const basic_new_grid_to_organize &) {
     p_out << "new grid to organize";
     return p_out;
   }
 
-  std::shared_ptr<typ::grid> grid;
+  std::shared_ptr<t_grid> grid;
 };
 
+using new_grid_to_organize = basic_new_grid_to_organize<typ::grid>;
+
 /// \brief Publiished when a grid was assembled
-struct assembly_finished {
-  assembly_finished() = default;
-  explicit assembly_finished(std::shared_ptr<typ::grid> p_grid)
+///
+/// \tparam t_grid type of grid, like \p typ::grid or \p typ::fixed_grid
+template <typename t_grid> struct basic_assembly_finished {
+  basic_assembly_finished() = default;
+  explicit basic_assembly_finished(std::shared_ptr<t_grid> p_grid)
       : grid(p_grid) {}
   friend std::ostream &operator<<(std::ostream &p_out,
-                                  const assembly_finished &p_evt) {
+                                  const basic_assembly_finished &p_evt) {
     if (p_evt.grid) {
       p_out << "organization_finished - grid organized: " << *(p_evt.grid);
     } else {
@@ -44,9 +50,11 @@ struct assembly_finished {
     return p_out;
   }
 
-  std::shared_ptr<typ::grid> grid;
+  std::shared_ptr<t_grid> grid;
 };
 
+using assembly_finished = basic_assembly_finished<typ::grid>;
+
 /// \brief Published when all attemps of assembling grids should stop
 struct stop_organizing {
   stop_organizing() = default;
@@ -3,14 +3,25 @@
 
 /// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <iterator>
+#include <random>
+#include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+#include <tenacitas.lib.crosswords/alg/annealer.h>
 #include <tenacitas.lib.crosswords/alg/assembler.h>
+#include <tenacitas.lib.crosswords/alg/backtracking_organizer.h>
+#include <tenacitas.lib.crosswords/alg/beam_searcher.h>
+#include <tenacitas.lib.crosswords/alg/clusterer.h>
+#include <tenacitas.lib.crosswords/alg/concurrent_filler.h>
+#include <tenacitas.lib.crosswords/alg/portfolio.h>
 #include <tenacitas.lib.crosswords/typ/grid.h>
 #include <tenacitas.lib.log/alg/logger.h>
 #include <tenacitas.lib.program/alg/options.h>
@@ -29,6 +40,80 @@ std::string print(const std::vector<std::pair<t_first, t_second>> &p_vector) {
   return _stream.str();
 }
 
+/// \brief Words of the sets used to compare the organizers
+const std::vector<crosswords::typ::word> all_words{
+    "afunilar", "viravira", "badalar", "farelos", "lesante",
+    "renovar",  "salutar",  "sibliar", "sideral", "aguipa",
+    "aresta",   "avivar",   "crepom",  "debute",  "exumar",
+    "rapina",   "teatro",   "tamara",  "usina",   "agito",
+    "atoba",    "gases",    "idade",   "lados",   "regis"};
+
+/// \brief Entries of \p p_words, each one explained by "expl " and the word
+template <typename t_words>
+crosswords::typ::entries make_entries(const t_words &p_words) {
+  crosswords::typ::entries _entries;
+  for (const crosswords::typ::word &_word : p_words) {
+    _entries.add_entry(crosswords::typ::word{_word}, "expl " + _word);
+  }
+  return _entries;
+}
+
+/// \brief \p p_count sets of \p p_size words of \p all_words, where each set
+/// has the first words after shuffling all the words again
+std::vector<crosswords::typ::entries>
+make_sets(size_t p_count, size_t p_size, uint32_t p_seed = 1) {
+  std::vector<crosswords::typ::word> _all{all_words};
+  std::mt19937 _random{p_seed};
+  std::vector<crosswords::typ::entries> _sets;
+  for (size_t _i = 0; _i < p_count; ++_i) {
+    std::shuffle(_all.begin(), _all.end(), _random);
+    _sets.push_back(make_entries(std::vector<crosswords::typ::word>{
+        _all.begin(),
+        std::next(_all.begin(), static_cast<std::ptrdiff_t>(p_size))}));
+  }
+  return _sets;
+}
+
+/// \brief Permutation of all the entries of \p p_entries, in their order
+crosswords::typ::permutation
+make_permutation(const crosswords::typ::entries &p_entries) {
+  crosswords::typ::permutation _permutation;
+  for (auto _entry = p_entries.begin(); _entry != p_entries.end(); ++_entry) {
+    _permutation.push_back(_entry);
+  }
+  return _permutation;
+}
+
+/// \brief Permutation of all the entries of \p p_entries, after sorting them
+/// as the assembler does
+crosswords::typ::permutation
+make_sorted_permutation(crosswords::typ::entries &p_entries) {
+  crosswords::bus::internal::sort_entries(p_entries);
+  return make_permutation(p_entries);
+}
+
+/// \brief Tries 10 shuffles of the words of \p p_entries in 9x9 grids with
+/// the same \p p_organizer, as a worker of the assembler does, adding the
+/// positions tried to \p p_nodes
+template <typename t_organizer>
+bool organize_shuffles(t_organizer &p_organizer,
+                       const crosswords::typ::entries &p_entries,
+                       uint64_t &p_nodes) {
+  using namespace crosswords;
+  typ::permutation _permutation{make_permutation(p_entries)};
+  std::mt19937 _random{7};
+  for (int _i = 0; _i < 10; ++_i) {
+    std::shuffle(_permutation.begin(), _permutation.end(), _random);
+    const bool _organized{p_organizer(std::make_shared<typ::grid>(
+        _permutation, typ::index{9}, typ::index{9}))};
+    p_nodes += p_organizer.get_num_nodes();
+    if (_organized) {
+      return true;
+    }
+  }
+  return false;
+}
+
 struct test_000 {
   static std::string desc() {
     return "organizing 'entries' with one entry in a 'grid' not big enough";
@@ -75,7 +160,7 @@ struct test_001 {
 
     bus::internal::first_word_positioner _first_word_positioner;
 
-    bool _stop{false};
+    std::atomic<bool> _stop{false};
 
     _first_word_positioner(_stop, _grid);
 
@@ -96,7 +181,7 @@ struct test_003 {
 
   bool operator()(const program::alg::options &) {
     using namespace crosswords;
-    bool _stop{false};
+    std::atomic<bool> _stop{false};
     auto _vector = bus::internal::find_intersections(_stop, "open", "never");
     if (_vector.empty()) {
       TNCT_LOG_ERR("intersect not found");
@@ -117,7 +202,7 @@ struct test_004 {
 
   bool operator()(const program::alg::options &) {
     using namespace crosswords;
-    bool _stop{false};
+    std::atomic<bool> _stop{false};
     auto _vector = bus::internal::find_intersections(_stop, "open", "black");
     if (!_vector.empty()) {
       TNCT_LOG_ERR("intersect found: ", print(_vector));
@@ -135,7 +220,7 @@ struct test_005 {
 
   bool operator()(const program::alg::options &) {
     using namespace crosswords;
-    bool _stop{false};
+    std::atomic<bool> _stop{false};
     auto _vector = bus::internal::find_intersections(_stop, "open", "old");
     if (_vector.empty()) {
       TNCT_LOG_ERR("intersect not found");
@@ -153,7 +238,7 @@ struct test_006 {
 
   bool operator()(const program::alg::options &) {
     using namespace crosswords;
-    bool _stop{false};
+    std::atomic<bool> _stop{false};
     auto _vector = bus::internal::find_intersections(_stop, "open", "abcn");
     if (_vector.empty()) {
       TNCT_LOG_ERR("intersect not found");
@@ -460,7 +545,7 @@ struct test_013 {
               typ::orientation::vert);
 
     TNCT_LOG_TST(_grid);
-    bool _stop{false};
+    std::atomic<bool> _stop{false};
     if (!bus::internal::position(_stop, _grid, _grid.begin(),
                                  std::next(_grid.begin()))) {
       TNCT_LOG_ERR('\'', std::next(_grid.begin(), 1)->get_word(),
@@ -501,7 +586,7 @@ struct test_014 {
               typ::orientation::hori);
 
     TNCT_LOG_TST(_grid);
-    bool _stop{false};
+    std::atomic<bool> _stop{false};
     if (!bus::internal::position(_stop, _grid, _grid.begin(),
                                  std::next(_grid.begin()))) {
       TNCT_LOG_ERR('\'', std::next(_grid.begin(), 1)->get_word(),
@@ -1348,7 +1433,8 @@ struct test_030 {
     }
     TNCT_LOG_TST("Not solved, as expected, and number of attempts = ",
                  m_solver.get_num_attempts());
-    return true;
+    // 25! does not fit in 64 bits, but the attempts are limited to 10000
+    return m_solver.get_num_attempts() == 10000;
   }
 
 private:
@@ -1403,7 +1489,9 @@ struct test_031 {
     }
     TNCT_LOG_TST("Not solved, as expected, and number of attempts = ",
                  m_solver.get_num_attempts());
-    return true;
+    // 25! does not fit in 64 bits, but the attempts stop after 5000
+    return (m_solver.get_num_attempts() >= 5000) &&
+           (m_solver.get_num_attempts() < 100000);
   }
 
 private:
@@ -1411,6 +1499,1574 @@ private:
   crosswords::bus::assembler m_solver{m_dispatcher};
 };
 
+struct test_032 {
+  static std::string desc() {
+    return "Intersections found with masks agree with letter by letter search, "
+           "for words up to 32 letters and longer";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    const std::vector<typ::word> _words{
+        "open",   "never", "abcn", "old", "viravira", "afunilar",
+        "salutar", "ação", "abcdefghijklmnopqrstuvwxyzabcdef",
+        "abcdefghijklmnopqrstuvwxyzabcdefghij"};
+
+    // all the words are coded by the same alphabet, as in a grid
+    typ::alphabet _alphabet;
+    for (const typ::word &_word : _words) {
+      _alphabet.add(_word);
+    }
+
+    std::atomic<bool> _stop{false};
+    for (const typ::word &_word_positioned : _words) {
+      const typ::letters _positioned{_alphabet.encode(_word_positioned)};
+      for (const typ::word &_word_to_position : _words) {
+        const typ::letters _to_position{_alphabet.encode(_word_to_position)};
+        typ::coordinates _expected;
+        for (typ::index _i = 0; _i < typ::get_size(_positioned); ++_i) {
+          for (typ::index _j = 0; _j < typ::get_size(_to_position); ++_j) {
+            if (_positioned[_i] == _to_position[_j]) {
+              _expected.push_back({_j, _i});
+            }
+          }
+        }
+        auto _found{
+            bus::internal::find_intersections(_stop, _positioned, _to_position)};
+        if (_found != _expected) {
+          TNCT_LOG_ERR("intersections between '", _word_positioned, "' and '",
+                       _word_to_position, "' should be ", print(_expected),
+                       ", but they are ", print(_found));
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+struct test_033 {
+  static std::string desc() {
+    return "Solving a grid with dimensions defined at compile time gives the "
+           "same result as with dimensions defined at run time";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries{{"viravira", "expl viravira"},
+                          {"exumar", "expl exumar"},
+                          {"afunilar", "expl afunilar"},
+                          {"rapina", "expl rapina"},
+                          {"teatro", "expl teatro"}};
+
+    bus::assembler _dynamic_solver(async::alg::dispatcher::create());
+    auto _start{std::chrono::high_resolution_clock::now()};
+    std::shared_ptr<typ::grid> _dynamic{
+        _dynamic_solver.start(_entries, typ::index{11}, typ::index{11}, 1)};
+    std::chrono::duration<double> _dynamic_time{
+        std::chrono::high_resolution_clock::now() - _start};
+
+    bus::basic_assembler<typ::fixed_grid<11, 11>> _fixed_solver(
+        async::alg::dispatcher::create());
+    _start = std::chrono::high_resolution_clock::now();
+    std::shared_ptr<typ::fixed_grid<11, 11>> _fixed{
+        _fixed_solver.start(_entries, typ::index{11}, typ::index{11}, 1)};
+    std::chrono::duration<double> _fixed_time{
+        std::chrono::high_resolution_clock::now() - _start};
+
+    TNCT_LOG_TST("dynamic time: ", _dynamic_time.count(),
+                 ", fixed time: ", _fixed_time.count());
+
+    if (!_dynamic || !_fixed) {
+      TNCT_LOG_ERR("both grids should have been solved");
+      return false;
+    }
+    TNCT_LOG_TST(*_fixed);
+
+    std::stringstream _dynamic_out;
+    std::stringstream _fixed_out;
+    _dynamic_out << *_dynamic;
+    _fixed_out << *_fixed;
+    if (_dynamic_out.str() != _fixed_out.str()) {
+      TNCT_LOG_ERR("grids should be equal, but they are ", *_dynamic, " and ",
+                   *_fixed);
+      return false;
+    }
+    return true;
+  }
+};
+
+struct test_034 {
+  static std::string desc() {
+    return "Organizers with different policies organize the same grid, and "
+           "'isolated_word_pruning' refuses a word without common letters";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries{{"viravira", "expl viravira"},
+                          {"exumar", "expl exumar"},
+                          {"afunilar", "expl afunilar"},
+                          {"rapina", "expl rapina"},
+                          {"teatro", "expl teatro"}};
+
+    typ::permutation _permutation{make_permutation(_entries)};
+
+    if (!organize<bus::internal::basic_organizer<typ::grid>, typ::grid>(
+            "default", _permutation) ||
+        !organize<bus::internal::basic_organizer<typ::grid, bus::longest_first,
+                                                 bus::row_major_anchors,
+                                                 bus::most_crossings>,
+                  typ::grid>("longest first, most crossings", _permutation) ||
+        !organize<bus::internal::basic_organizer<
+                      typ::fixed_grid<11, 11>, bus::permutation_order,
+                      bus::row_major_anchors, bus::first_fit,
+                      bus::isolated_word_pruning, bus::periodic_poll<64>>,
+                  typ::fixed_grid<11, 11>>(
+            "fixed grid, isolated word pruning, periodic poll",
+            _permutation)) {
+      return false;
+    }
+
+    typ::entries _isolated{
+        {"mouth", "expl 1"}, {"open", "expl 2"}, {"sky", "expl 3"}};
+    typ::permutation _isolated_permutation{_isolated.begin(),
+                                           std::next(_isolated.begin()),
+                                           std::next(_isolated.begin(), 2)};
+    auto _grid{std::make_shared<typ::grid>(_isolated_permutation,
+                                           typ::index{11}, typ::index{11})};
+    bus::internal::basic_organizer<typ::grid, bus::permutation_order,
+                                   bus::row_major_anchors, bus::first_fit,
+                                   bus::isolated_word_pruning>
+        _organizer;
+    if (_organizer(_grid)) {
+      TNCT_LOG_ERR("'sky' has no letter in common, but grid was organized");
+      return false;
+    }
+    return true;
+  }
+
+private:
+  template <typename t_organizer, typename t_grid>
+  bool organize(std::string_view p_name,
+                const crosswords::typ::permutation &p_permutation) {
+    using namespace crosswords;
+    auto _grid{std::make_shared<t_grid>(p_permutation, typ::index{11},
+                                        typ::index{11})};
+    t_organizer _organizer;
+    auto _start{std::chrono::high_resolution_clock::now()};
+    const bool _organized{_organizer(_grid)};
+    std::chrono::duration<double> _time{
+        std::chrono::high_resolution_clock::now() - _start};
+    if (!_organized) {
+      TNCT_LOG_ERR(p_name, ": grid not organized");
+      return false;
+    }
+    TNCT_LOG_TST(p_name, ": ", _time.count(), "s ", *_grid);
+    return true;
+  }
+};
+
+struct test_035 {
+  static std::string desc() {
+    return "Forward checking counts, kept incrementally while words are "
+           "positioned and removed, agree with counts recomputed from the grid";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries{{"viravira", "expl viravira"},
+                          {"exumar", "expl exumar"},
+                          {"afunilar", "expl afunilar"},
+                          {"rapina", "expl rapina"},
+                          {"teatro", "expl teatro"}};
+    typ::permutation _permutation{make_permutation(_entries)};
+
+    typ::grid _grid(_permutation, typ::index{9}, typ::index{11});
+    bus::internal::basic_forward_checker<typ::grid> _checker;
+    _checker.start(_grid);
+
+    _grid.set(_grid.begin(), typ::index{4}, typ::index{1},
+              typ::orientation::hori);
+    _checker.anchor(_grid.begin());
+    if (!check(_grid, _checker)) {
+      return false;
+    }
+
+    std::vector<typ::grid::const_layout_ite> _positioned{_grid.begin()};
+    std::vector<bus::internal::placement> _candidates;
+    std::atomic<bool> _stop{false};
+    size_t _placed{0};
+    for (auto _layout = std::next(_grid.begin()); _layout != _grid.end();
+         ++_layout) {
+      bus::internal::crossing_candidates(_stop, _grid, _positioned, _layout,
+                                         _candidates);
+      if (_candidates.empty()) {
+        continue;
+      }
+      // tries all the candidates, keeping the last one
+      for (size_t _i = 0; _i < _candidates.size(); ++_i) {
+        _checker.place(_grid, _layout, _candidates[_i]);
+        if (!check(_grid, _checker)) {
+          return false;
+        }
+        if (_i + 1 < _candidates.size()) {
+          _checker.undo(_grid);
+          if (!check(_grid, _checker)) {
+            return false;
+          }
+        }
+      }
+      _positioned.push_back(_layout);
+      ++_placed;
+    }
+    TNCT_LOG_TST(_placed, " words positioned", _grid);
+
+    for (; _placed > 0; --_placed) {
+      _checker.undo(_grid);
+      if (!check(_grid, _checker)) {
+        return false;
+      }
+    }
+    return _placed == 0;
+  }
+
+private:
+  bool check(const crosswords::typ::grid &p_grid,
+             const crosswords::bus::internal::basic_forward_checker<
+                 crosswords::typ::grid> &p_checker) {
+    using namespace crosswords;
+    for (auto _layout = p_grid.begin(); _layout != p_grid.end(); ++_layout) {
+      if (_layout->is_positioned()) {
+        continue;
+      }
+      size_t _count{0};
+      for (typ::index _row = 0; _row < p_grid.get_num_rows(); ++_row) {
+        for (typ::index _col = 0; _col < p_grid.get_num_cols(); ++_col) {
+          if ((_col + _layout->get_size() <= p_grid.get_num_cols()) &&
+              p_grid.fits_horizontally(_row, _col, _layout)) {
+            ++_count;
+          }
+          if ((_row + _layout->get_size() <= p_grid.get_num_rows()) &&
+              p_grid.fits_vertically(_row, _col, _layout)) {
+            ++_count;
+          }
+        }
+      }
+      if (_count != p_checker.get_count(_layout)) {
+        TNCT_LOG_ERR("'", _layout->get_word(), "' has ", _count,
+                     " places, but the checker counted ",
+                     p_checker.get_count(_layout), p_grid);
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+struct test_036 {
+  static std::string desc() {
+    return "Backtracking organizer organizes a permutation that the greedy "
+           "organizer can not";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries{{"rapina", "expl rapina"}, {"farelos", "expl farelos"},
+                          {"aresta", "expl aresta"}, {"lados", "expl lados"},
+                          {"agito", "expl agito"},   {"avivar", "expl avivar"},
+                          {"debute", "expl debute"}};
+    typ::permutation _permutation{make_permutation(_entries)};
+
+    auto _greedy_grid{std::make_shared<typ::grid>(_permutation, typ::index{9},
+                                                  typ::index{9})};
+    bus::internal::organizer _greedy;
+    auto _start{std::chrono::high_resolution_clock::now()};
+    const bool _greedy_organized{_greedy(_greedy_grid)};
+    std::chrono::duration<double> _greedy_time{
+        std::chrono::high_resolution_clock::now() - _start};
+
+    auto _grid{std::make_shared<typ::grid>(_permutation, typ::index{9},
+                                           typ::index{9})};
+    bus::internal::backtracking_organizer _backtracking;
+    _start = std::chrono::high_resolution_clock::now();
+    const bool _organized{_backtracking(_grid)};
+    std::chrono::duration<double> _time{
+        std::chrono::high_resolution_clock::now() - _start};
+
+    TNCT_LOG_TST("greedy: ", _greedy_organized, " in ", _greedy_time.count(),
+                 "s; backtracking: ", _organized, " in ", _time.count(),
+                 "s, with ", _backtracking.get_num_nodes(), " positions");
+
+    if (_greedy_organized) {
+      TNCT_LOG_ERR("greedy organizer should not organize this permutation");
+      return false;
+    }
+    if (!_organized) {
+      TNCT_LOG_ERR("backtracking organizer should organize this permutation");
+      return false;
+    }
+    TNCT_LOG_TST(*_grid);
+    return true;
+  }
+};
+
+struct test_037 {
+  static std::string desc() {
+    return "Most constrained first word selection organizes grids trying "
+           "fewer positions than the order of the permutation";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    uint64_t _permutation_nodes{0};
+    uint64_t _constrained_nodes{0};
+    // 40 sets of 16 words
+    for (const typ::entries &_entries : make_sets(40, 16)) {
+      typ::permutation _permutation{make_permutation(_entries)};
+
+      bus::internal::backtracking_organizer _in_permutation;
+      _in_permutation(std::make_shared<typ::grid>(_permutation, typ::index{11},
+                                                  typ::index{11}));
+      _permutation_nodes += _in_permutation.get_num_nodes();
+
+      auto _grid{std::make_shared<typ::grid>(_permutation, typ::index{11},
+                                             typ::index{11})};
+      bus::internal::basic_backtracking_organizer<typ::grid,
+                                                  bus::most_constrained_first>
+          _constrained;
+      if (!_constrained(_grid)) {
+        TNCT_LOG_ERR("most constrained first should organize the grid");
+        return false;
+      }
+      _constrained_nodes += _constrained.get_num_nodes();
+    }
+
+    TNCT_LOG_TST("positions tried in the order of the permutation = ",
+                 _permutation_nodes, ", most constrained first = ",
+                 _constrained_nodes);
+    return _constrained_nodes < _permutation_nodes;
+  }
+};
+
+struct test_038 {
+  static std::string desc() {
+    return "Lookahead value ordering organizes grids trying fewer positions "
+           "than the order of the intersections";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    uint64_t _intersection_nodes{0};
+    uint64_t _lookahead_nodes{0};
+    // 40 sets of 16 words
+    for (const typ::entries &_entries : make_sets(40, 16)) {
+      typ::permutation _permutation{make_permutation(_entries)};
+
+      bus::internal::backtracking_organizer _in_intersection_order;
+      _in_intersection_order(std::make_shared<typ::grid>(
+          _permutation, typ::index{11}, typ::index{11}));
+      _intersection_nodes += _in_intersection_order.get_num_nodes();
+
+      auto _grid{std::make_shared<typ::grid>(_permutation, typ::index{11},
+                                             typ::index{11})};
+      bus::internal::basic_backtracking_organizer<
+          typ::grid, bus::next_in_permutation, bus::row_major_anchors,
+          bus::lookahead_order>
+          _lookahead;
+      if (!_lookahead(_grid)) {
+        TNCT_LOG_ERR("lookahead should organize the grid");
+        return false;
+      }
+      _lookahead_nodes += _lookahead.get_num_nodes();
+    }
+
+    TNCT_LOG_TST("positions tried in the order of the intersections = ",
+                 _intersection_nodes, ", with lookahead = ", _lookahead_nodes);
+    return _lookahead_nodes < _intersection_nodes;
+  }
+};
+
+struct test_039 {
+  static std::string desc() {
+    return "Conflict directed word selection, learning across permutations, "
+           "organizes more hard word sets than most constrained first";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    // 20 sets of 14 words, too many for a 9x9 grid to be easy
+    size_t _constrained_organized{0};
+    size_t _conflict_organized{0};
+    uint64_t _nodes{0};
+    for (const typ::entries &_entries : make_sets(20, 14)) {
+      bus::internal::basic_backtracking_organizer<typ::grid,
+                                                  bus::most_constrained_first>
+          _constrained{2000};
+      _constrained_organized +=
+          organize_shuffles(_constrained, _entries, _nodes);
+
+      bus::internal::basic_backtracking_organizer<typ::grid,
+                                                  bus::conflict_directed>
+          _conflict{2000};
+      _conflict_organized += organize_shuffles(_conflict, _entries, _nodes);
+    }
+
+    TNCT_LOG_TST("sets organized by most constrained first = ",
+                 _constrained_organized,
+                 ", by conflict directed = ", _conflict_organized);
+    return _conflict_organized > _constrained_organized;
+  }
+};
+
+struct test_040 {
+  static std::string desc() {
+    return "Organizers sharing a 'nogood_store' try fewer positions, and "
+           "organize the same word sets, as organizers without it";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    using organizer = bus::internal::basic_backtracking_organizer<
+        typ::grid, bus::most_constrained_first>;
+
+    size_t _organized{0};
+    size_t _organized_with_nogoods{0};
+    uint64_t _nodes{0};
+    uint64_t _nodes_with_nogoods{0};
+    for (const typ::entries &_entries : make_sets(20, 14)) {
+      organizer _organizer{2000};
+      _organized += organize_shuffles(_organizer, _entries, _nodes);
+
+      organizer _with_nogoods{2000};
+      _with_nogoods.set_nogoods(std::make_shared<typ::nogood_store>(1 << 16));
+      _organized_with_nogoods +=
+          organize_shuffles(_with_nogoods, _entries, _nodes_with_nogoods);
+    }
+
+    TNCT_LOG_TST("without nogoods: ", _organized, " organized, ", _nodes,
+                 " positions; with nogoods: ", _organized_with_nogoods,
+                 " organized, ", _nodes_with_nogoods, " positions");
+    if ((_organized_with_nogoods != _organized) ||
+        (_nodes_with_nogoods >= _nodes)) {
+      return false;
+    }
+
+    // the assembler gives the same store to the organizers of all the threads
+    static_assert(bus::internal::shares_nogoods<organizer>::value);
+    static_assert(!bus::internal::shares_nogoods<bus::internal::organizer>::value);
+
+    typ::entries _entries{{"rapina", "expl rapina"},
+                          {"farelos", "expl farelos"},
+                          {"aresta", "expl aresta"},
+                          {"lados", "expl lados"},
+                          {"agito", "expl agito"},
+                          {"avivar", "expl avivar"},
+                          {"debute", "expl debute"}};
+    bus::basic_assembler<typ::grid, organizer> _assembler(
+        async::alg::dispatcher::create());
+    std::shared_ptr<typ::grid> _grid{
+        _assembler.start(_entries, typ::index{9}, typ::index{9}, 4, 200)};
+    if (!_grid) {
+      TNCT_LOG_ERR("the assembler should organize the grid");
+      return false;
+    }
+    TNCT_LOG_TST(*_grid);
+    return true;
+  }
+};
+
+struct test_041 {
+  static std::string desc() {
+    return "Organizers sharing a 'transposition_table' try fewer positions, "
+           "and organize the same word sets, as organizers without it";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    using organizer = bus::internal::basic_backtracking_organizer<
+        typ::grid, bus::most_constrained_first>;
+
+    size_t _organized{0};
+    size_t _organized_with_table{0};
+    uint64_t _nodes{0};
+    uint64_t _nodes_with_table{0};
+    for (const typ::entries &_entries : make_sets(20, 14)) {
+      organizer _organizer{2000};
+      _organized += organize_shuffles(_organizer, _entries, _nodes);
+
+      organizer _with_table{2000};
+      _with_table.set_transpositions(
+          std::make_shared<typ::transposition_table>(1 << 20));
+      _organized_with_table +=
+          organize_shuffles(_with_table, _entries, _nodes_with_table);
+    }
+
+    TNCT_LOG_TST("without transposition table: ", _organized, " organized, ",
+                 _nodes, " positions; with it: ", _organized_with_table,
+                 " organized, ", _nodes_with_table, " positions");
+    if ((_organized_with_table != _organized) ||
+        (_nodes_with_table >= _nodes)) {
+      return false;
+    }
+
+    // the assembler creates the table with the memory informed
+    static_assert(bus::internal::shares_transpositions<organizer>::value);
+
+    typ::entries _entries{{"rapina", "expl rapina"},
+                          {"farelos", "expl farelos"},
+                          {"aresta", "expl aresta"},
+                          {"lados", "expl lados"},
+                          {"agito", "expl agito"},
+                          {"avivar", "expl avivar"},
+                          {"debute", "expl debute"}};
+    bus::basic_assembler<typ::grid, organizer> _assembler(
+        async::alg::dispatcher::create());
+    std::shared_ptr<typ::grid> _grid{_assembler.start(
+        _entries, typ::index{9}, typ::index{9}, 4, 200, 1 << 16)};
+    if (!_grid) {
+      TNCT_LOG_ERR("the assembler should organize the grid");
+      return false;
+    }
+    TNCT_LOG_TST(*_grid);
+    return true;
+  }
+};
+
+struct test_042 {
+  static std::string desc() {
+    return "Canonical anchors position the first word in half the places of "
+           "row major anchors in a square grid, and organize the same sets "
+           "trying fewer positions";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    {
+      typ::entries _entries{{"rapina", "expl rapina"},
+                            {"aresta", "expl aresta"}};
+      typ::permutation _permutation{_entries.begin(),
+                                    std::next(_entries.begin())};
+
+      typ::grid _square{_permutation, typ::index{11}, typ::index{11}};
+      bus::canonical_anchors<typ::grid> _canonical;
+      _canonical(m_stop, _square);
+      if (_canonical.get_num_anchors() != 11 * 6) {
+        TNCT_LOG_ERR("there should be 66 anchors in a square grid, but there "
+                     "are ",
+                     _canonical.get_num_anchors());
+        return false;
+      }
+
+      typ::grid _rectangle{_permutation, typ::index{9}, typ::index{11}};
+      bus::center_out_anchors<typ::grid> _center_out;
+      _center_out(m_stop, _rectangle);
+      if (_center_out.get_num_anchors() != (9 * 6) + (4 * 11)) {
+        TNCT_LOG_ERR("there should be 98 anchors in a 9x11 grid, but there "
+                     "are ",
+                     _center_out.get_num_anchors());
+        return false;
+      }
+      // 'rapina' centered in the middle row
+      const typ::layout &_first{*_rectangle.begin()};
+      if ((_first.get_row() != 4) ||
+          ((_first.get_col() != 2) && (_first.get_col() != 3)) ||
+          (_first.get_orientation() != typ::orientation::hori)) {
+        TNCT_LOG_ERR("first anchor should be at the center, but it is ",
+                     _first);
+        return false;
+      }
+    }
+
+    // 40 sets of 12 words in 9x9 grids, some with no organization
+    size_t _row_major_organized{0};
+    size_t _canonical_organized{0};
+    uint64_t _row_major_nodes{0};
+    uint64_t _canonical_nodes{0};
+    for (const typ::entries &_entries : make_sets(40, 12)) {
+      typ::permutation _permutation{make_permutation(_entries)};
+
+      bus::internal::basic_backtracking_organizer<
+          typ::grid, bus::most_constrained_first, bus::row_major_anchors>
+          _row_major{5000};
+      _row_major_organized += _row_major(std::make_shared<typ::grid>(
+          _permutation, typ::index{9}, typ::index{9}));
+      _row_major_nodes += _row_major.get_num_nodes();
+
+      bus::internal::basic_backtracking_organizer<
+          typ::grid, bus::most_constrained_first, bus::canonical_anchors>
+          _canonical{5000};
+      _canonical_organized += _canonical(std::make_shared<typ::grid>(
+          _permutation, typ::index{9}, typ::index{9}));
+      _canonical_nodes += _canonical.get_num_nodes();
+    }
+
+    TNCT_LOG_TST("row major anchors: ", _row_major_organized, " organized, ",
+                 _row_major_nodes, " positions; canonical anchors: ",
+                 _canonical_organized, " organized, ", _canonical_nodes,
+                 " positions");
+    return (_canonical_organized == _row_major_organized) &&
+           (_canonical_nodes < _row_major_nodes);
+  }
+
+private:
+  std::atomic<bool> m_stop{false};
+};
+
+struct test_043 {
+  static std::string desc() {
+    return "Randomized restarts with the Luby schedule organize more sets than "
+           "a deterministic search with the same maximum number of positions";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    const std::vector<uint64_t> _expected{1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1,
+                                          2, 4, 8};
+    bus::luby_schedule _luby;
+    for (uint64_t _restart = 0; _restart < _expected.size(); ++_restart) {
+      if (_luby(_restart) != _expected[_restart]) {
+        TNCT_LOG_ERR("restart ", _restart, " should be ", _expected[_restart],
+                     ", but it is ", _luby(_restart));
+        return false;
+      }
+    }
+
+    // 40 sets of 12 words in 9x9 grids, the same as in test_042
+    size_t _deterministic_organized{0};
+    size_t _restarting_organized{0};
+    uint64_t _deterministic_nodes{0};
+    uint64_t _restarting_nodes{0};
+    uint64_t _seed{0};
+    for (const typ::entries &_entries : make_sets(40, 12)) {
+      typ::permutation _permutation{make_permutation(_entries)};
+
+      bus::internal::basic_backtracking_organizer<
+          typ::grid, bus::most_constrained_first, bus::canonical_anchors>
+          _deterministic{5000};
+      _deterministic_organized += _deterministic(std::make_shared<typ::grid>(
+          _permutation, typ::index{9}, typ::index{9}));
+      _deterministic_nodes += _deterministic.get_num_nodes();
+
+      bus::internal::restarting_organizer _restarting{100, 5000, _seed};
+      _restarting_organized += _restarting(std::make_shared<typ::grid>(
+          _permutation, typ::index{9}, typ::index{9}));
+      _restarting_nodes += _restarting.get_num_nodes();
+
+      // the same seed reproduces the same search
+      bus::internal::restarting_organizer _again{100, 5000, _seed};
+      _again(std::make_shared<typ::grid>(_permutation, typ::index{9},
+                                         typ::index{9}));
+      if (_again.get_num_nodes() != _restarting.get_num_nodes()) {
+        TNCT_LOG_ERR("seed ", _seed, " tried ", _restarting.get_num_nodes(),
+                     " positions, and then ", _again.get_num_nodes());
+        return false;
+      }
+      ++_seed;
+    }
+
+    TNCT_LOG_TST("deterministic: ", _deterministic_organized, " organized, ",
+                 _deterministic_nodes, " positions; restarting: ",
+                 _restarting_organized, " organized, ", _restarting_nodes,
+                 " positions");
+    if (_restarting_organized <= _deterministic_organized) {
+      return false;
+    }
+
+    // the assembler gives each organizer its own seed
+    static_assert(
+        bus::internal::has_seed<bus::internal::restarting_organizer>::value);
+    static_assert(!bus::internal::has_seed<bus::internal::organizer>::value);
+
+    typ::entries _entries{{"rapina", "expl rapina"},
+                          {"farelos", "expl farelos"},
+                          {"aresta", "expl aresta"},
+                          {"lados", "expl lados"},
+                          {"agito", "expl agito"},
+                          {"avivar", "expl avivar"},
+                          {"debute", "expl debute"}};
+    bus::basic_assembler<typ::grid, bus::internal::restarting_organizer>
+        _assembler(async::alg::dispatcher::create());
+    std::shared_ptr<typ::grid> _grid{
+        _assembler.start(_entries, typ::index{9}, typ::index{9}, 4, 200)};
+    if (!_grid) {
+      TNCT_LOG_ERR("the assembler should organize the grid");
+      return false;
+    }
+    TNCT_LOG_TST(*_grid);
+    return true;
+  }
+};
+
+struct test_044 {
+  static std::string desc() {
+    return "Simulated annealing positions, connected, more of 42 words in a "
+           "11x11 grid than its greedy start";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries;
+    for (const char *_word :
+         {"chat",    "crepom",   "debute",  "regis",   "gases",   "exumar",
+          "dias",    "pai",      "lesante", "ma",      "afunilar", "atoba",
+          "ot",      "viravira", "sideral", "gim",     "oval",    "rapina",
+          "lados",   "rotor",    "aresta",  "poxa",    "hexa",    "aguipa",
+          "tim",     "salutar",  "renovar", "eg",      "badalar", "usina",
+          "teatro",  "esse",     "sola",    "avivar",  "idade",   "farelos",
+          "st",      "sibliar",  "pop",     "agito",   "inox",    "tamara"}) {
+      _entries.add_entry(typ::word{_word}, "expl " + typ::word{_word});
+    }
+
+    // with no steps, the grid is the greedy start
+    bus::annealer _greedy{0};
+    std::shared_ptr<typ::grid> _start{
+        _greedy.start(_entries, typ::index{11}, typ::index{11}, 1, 1)};
+
+    bus::annealer _annealer{20000};
+    std::shared_ptr<typ::grid> _grid{
+        _annealer.start(_entries, typ::index{11}, typ::index{11}, 4, 1)};
+    if (!_start || !_grid) {
+      TNCT_LOG_ERR("the annealer should create the grids");
+      return false;
+    }
+
+    std::vector<typ::grid::const_layout_ite> _positioned;
+    for (auto _layout = _grid->begin(); _layout != _grid->end(); ++_layout) {
+      if (!_layout->is_positioned()) {
+        continue;
+      }
+      if (_grid->read(_layout) != _layout->get_letters()) {
+        TNCT_LOG_ERR("the cells of ", *_layout, " do not have its letters");
+        return false;
+      }
+      _positioned.push_back(_layout);
+    }
+
+    // all the words positioned are connected
+    std::vector<bool> _reached(_positioned.size(), false);
+    std::vector<size_t> _queue{0};
+    _reached[0] = true;
+    for (size_t _next = 0; _next < _queue.size(); ++_next) {
+      for (size_t _i = 0; _i < _positioned.size(); ++_i) {
+        if (!_reached[_i] && bus::internal::touch<typ::grid>(
+                                 _positioned[_queue[_next]], _positioned[_i])) {
+          _reached[_i] = true;
+          _queue.push_back(_i);
+        }
+      }
+    }
+    if (_queue.size() != _positioned.size()) {
+      TNCT_LOG_ERR("only ", _queue.size(), " of the ", _positioned.size(),
+                   " words positioned are connected");
+      return false;
+    }
+
+    const auto _start_positioned{
+        std::count_if(_start->begin(), _start->end(),
+                      [](const typ::layout &p_layout) {
+                        return p_layout.is_positioned();
+                      })};
+    TNCT_LOG_TST("greedy: ", _start_positioned, " words; annealing: ",
+                 _positioned.size(), " words in ",
+                 _annealer.get_num_steps(), " steps", *_grid);
+    return static_cast<size_t>(_start_positioned) < _positioned.size();
+  }
+};
+
+struct test_045 {
+  static std::string desc() {
+    return "Beam search, keeping 32 grids per depth, organizes more sets than "
+           "the backtracking organizer, expanding a bounded number of grids";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    // 40 sets of 12 words in 9x9 grids, the same as in test_042
+    size_t _backtracking_organized{0};
+    size_t _beam_organized{0};
+    uint64_t _max_expanded{0};
+    for (const typ::entries &_entries : make_sets(40, 12)) {
+      typ::permutation _permutation{make_permutation(_entries)};
+
+      bus::internal::basic_backtracking_organizer<
+          typ::grid, bus::most_constrained_first, bus::canonical_anchors>
+          _backtracking{5000};
+      _backtracking_organized += _backtracking(std::make_shared<typ::grid>(
+          _permutation, typ::index{9}, typ::index{9}));
+
+      bus::beam_searcher _beam;
+      std::shared_ptr<typ::grid> _grid{
+          _beam.start(_entries, typ::index{9}, typ::index{9}, 32, 4)};
+      if (!_grid) {
+        TNCT_LOG_ERR("no grid returned");
+        return false;
+      }
+      if (_grid->organized()) {
+        ++_beam_organized;
+      } else if (bus::internal::num_positioned(*_grid) == 0) {
+        TNCT_LOG_ERR("grid returned has no word positioned: ", *_grid);
+        return false;
+      }
+      _max_expanded = std::max(_max_expanded, _beam.get_num_expanded());
+    }
+
+    TNCT_LOG_TST("backtracking: ", _backtracking_organized,
+                 " organized; beam: ", _beam_organized,
+                 " organized, at most ", _max_expanded, " grids expanded");
+    // first level with 45 anchors, and then at most 32 grids with less
+    // than 40 places each, for 11 words
+    return (_beam_organized > _backtracking_organized) &&
+           (_max_expanded <= 45 + (32 * 40 * 11));
+  }
+};
+
+struct test_046 {
+  static std::string desc() {
+    return "Discrepancy permutations are generated once, in increasing number "
+           "of discrepancies from the longest first order, and assemble a "
+           "grid";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries{{"afunilar", "expl afunilar"},
+                          {"rapina", "expl rapina"},
+                          {"farelos", "expl farelos"},
+                          {"aresta", "expl aresta"},
+                          {"lados", "expl lados"},
+                          {"agito", "expl agito"},
+                          {"avivar", "expl avivar"},
+                          {"debute", "expl debute"}};
+
+    {
+      typ::entries _sorted{_entries};
+      bus::internal::sort_entries(_sorted);
+      typ::permutation _permutation{make_permutation(_sorted)};
+
+      bus::discrepancy_permutations<3> _permutations;
+      _permutations.start(_permutation);
+      std::set<std::string> _generated;
+      size_t _discrepancy{0};
+      typ::permutation _next;
+      while (true) {
+        const size_t _current{_permutations.get_discrepancy()};
+        if (!_permutations(_next)) {
+          break;
+        }
+        if (_current < _discrepancy) {
+          TNCT_LOG_ERR("a permutation with ", _current,
+                       " discrepancies after one with ", _discrepancy);
+          return false;
+        }
+        _discrepancy = _current;
+        std::string _words;
+        for (typ::entries::const_entry_ite _entry : _next) {
+          _words += _entry->get_word() + ' ';
+        }
+        if (_generated.empty() && (_words.find("afunilar ") != 0)) {
+          TNCT_LOG_ERR("first permutation should start with the longest "
+                       "word, but it is ",
+                       _words);
+          return false;
+        }
+        if (!_generated.insert(_words).second) {
+          TNCT_LOG_ERR("permutation ", _words, " generated twice");
+          return false;
+        }
+      }
+      // 1 + 28 + 322 + 1960 permutations with up to 3 discrepancies of 8
+      // words
+      if ((_generated.size() != 2311) ||
+          (_permutations.count(8).value() != 2311)) {
+        TNCT_LOG_ERR("there should be 2311 permutations, but ",
+                     _generated.size(), " were generated, and ",
+                     _permutations.count(8).value(), " were expected");
+        return false;
+      }
+    }
+
+    bus::basic_assembler<typ::grid, bus::internal::organizer,
+                         bus::discrepancy_permutations<2>>
+        _assembler(async::alg::dispatcher::create());
+    std::shared_ptr<typ::grid> _grid{
+        _assembler.start(_entries, typ::index{11}, typ::index{11}, 4)};
+    if (!_grid) {
+      TNCT_LOG_ERR("the assembler should organize the grid");
+      return false;
+    }
+    TNCT_LOG_TST("organized after ", _assembler.get_num_attempts(),
+                 " attempts", *_grid);
+    return true;
+  }
+};
+
+struct test_047 {
+  static std::string desc() {
+    return "Portfolio splits the threads by progress, returns the first grid "
+           "organized, or the one with more words positioned";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    {
+      const std::array<size_t, 3> _even{
+          bus::internal::shares<3>({1.0, 1.0, 1.0}, 8)};
+      const std::array<size_t, 3> _skewed{
+          bus::internal::shares<3>({1.0, 11.0, 1.0}, 8)};
+      if ((_even != std::array<size_t, 3>{3, 3, 2}) ||
+          (_skewed != std::array<size_t, 3>{2, 5, 1})) {
+        TNCT_LOG_ERR("shares should be 3, 3, 2 and 2, 5, 1, but they are ",
+                     _even[0], ", ", _even[1], ", ", _even[2], " and ",
+                     _skewed[0], ", ", _skewed[1], ", ", _skewed[2]);
+        return false;
+      }
+    }
+
+    {
+      typ::entries _entries{{"rapina", "expl rapina"},
+                            {"farelos", "expl farelos"},
+                            {"aresta", "expl aresta"},
+                            {"lados", "expl lados"},
+                            {"agito", "expl agito"},
+                            {"avivar", "expl avivar"},
+                            {"debute", "expl debute"}};
+      bus::portfolio _portfolio;
+      std::shared_ptr<typ::grid> _grid{
+          _portfolio.start(_entries, typ::index{9}, typ::index{9}, 4)};
+      if (!_grid || !_grid->organized() ||
+          (_portfolio.get_winner() == bus::portfolio::num_solvers)) {
+        TNCT_LOG_ERR("the portfolio should organize the grid");
+        return false;
+      }
+      TNCT_LOG_TST("solver ", _portfolio.get_winner(), " organized",
+                   *_grid);
+    }
+
+    // too many words for the assembler, which gives up, so the annealer gets
+    // more threads in the second round
+    typ::entries _entries;
+    for (const char *_word :
+         {"chat",    "crepom",   "debute",  "regis",   "gases",   "exumar",
+          "dias",    "pai",      "lesante", "ma",      "afunilar", "atoba",
+          "ot",      "viravira", "sideral", "gim",     "oval",    "rapina",
+          "lados",   "rotor",    "aresta",  "poxa",    "hexa",    "aguipa",
+          "tim",     "salutar",  "renovar", "eg",      "badalar", "usina",
+          "teatro",  "esse",     "sola",    "avivar",  "idade",   "farelos",
+          "st",      "sibliar",  "pop",     "agito",   "inox",    "tamara"}) {
+      _entries.add_entry(typ::word{_word}, "expl " + typ::word{_word});
+    }
+    bus::basic_portfolio<typ::grid, bus::assembler_solver<typ::grid>,
+                         bus::annealer_solver<typ::grid>>
+        _portfolio;
+    std::shared_ptr<typ::grid> _grid{
+        _portfolio.start(_entries, typ::index{10}, typ::index{10}, 6, 2)};
+    if (!_grid || _grid->organized()) {
+      TNCT_LOG_ERR("the portfolio should return a grid not organized");
+      return false;
+    }
+    TNCT_LOG_TST("best grid with ", bus::internal::num_positioned(*_grid),
+                 " words; threads of the last round: ",
+                 _portfolio.get_shares()[0], " and ",
+                 _portfolio.get_shares()[1], *_grid);
+    return (_portfolio.get_num_rounds() == 2) &&
+           (bus::internal::num_positioned(*_grid) > 0) &&
+           (_portfolio.get_shares()[1] > _portfolio.get_shares()[0]);
+  }
+};
+
+struct test_048 {
+  static std::string desc() {
+    return "Random permutations are drawn without repeats, and spread over the "
+           "last words, unlike the lexicographic ones";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    // all the 120 permutations of 5 words, once
+    if (!draw_all(5)) {
+      return false;
+    }
+
+    typ::entries _entries{
+        {"afunilar", "expl afunilar"}, {"viravira", "expl viravira"},
+        {"badalar", "expl badalar"},   {"farelos", "expl farelos"},
+        {"lesante", "expl lesante"},   {"aguipa", "expl aguipa"},
+        {"aresta", "expl aresta"},     {"usina", "expl usina"},
+        {"agito", "expl agito"},       {"lados", "expl lados"}};
+    typ::permutation _sorted{make_sorted_permutation(_entries)};
+
+    bus::lexicographic_permutations _lexicographic;
+    _lexicographic.start(_sorted);
+    bus::random_permutations _random{7};
+    _random.start(_sorted);
+    bus::random_permutations _other{8};
+    _other.start(_sorted);
+
+    std::set<typ::word> _lexicographic_last;
+    std::set<typ::word> _random_last;
+    bool _same_as_other{true};
+    typ::permutation _permutation;
+    typ::permutation _drawn;
+    for (uint64_t _draw = 0; _draw < 1000; ++_draw) {
+      _lexicographic(_permutation);
+      _lexicographic_last.insert(_permutation.back()->get_word());
+
+      _random(_permutation);
+      _random_last.insert(_permutation.back()->get_word());
+      // a worker can compute any draw
+      _random.at(_draw, _drawn);
+      if (_drawn != _permutation) {
+        TNCT_LOG_ERR("draw ", _draw, " is not the same computed directly");
+        return false;
+      }
+
+      _other(_drawn);
+      _same_as_other = _same_as_other && (_drawn == _permutation);
+    }
+    TNCT_LOG_TST("last words in 1000 permutations of 10 words: ",
+                 _lexicographic_last.size(), " lexicographic, ",
+                 _random_last.size(), " random");
+    if ((_lexicographic_last.size() != 1) || (_random_last.size() != 10) ||
+        _same_as_other) {
+      return false;
+    }
+
+    bus::basic_assembler<typ::grid, bus::internal::organizer,
+                         bus::random_permutations>
+        _assembler(async::alg::dispatcher::create());
+    _assembler.get_permutations().seed(3);
+    std::shared_ptr<typ::grid> _grid{
+        _assembler.start(_entries, typ::index{11}, typ::index{11}, 4, 1000)};
+    if (!_grid) {
+      TNCT_LOG_ERR("the assembler should organize the grid");
+      return false;
+    }
+    TNCT_LOG_TST("organized after ", _assembler.get_num_attempts(),
+                 " attempts", *_grid);
+    return true;
+  }
+
+private:
+  static bool draw_all(size_t p_num_words) {
+    using namespace crosswords;
+    typ::entries _entries;
+    for (size_t _i = 0; _i < p_num_words; ++_i) {
+      const typ::word _word(_i + 2, static_cast<char>('a' + _i));
+      _entries.add_entry(typ::word{_word}, "expl " + _word);
+    }
+    bus::random_permutations _random;
+    _random.start(make_sorted_permutation(_entries));
+
+    std::set<std::string> _drawn;
+    typ::permutation _permutation;
+    while (_random(_permutation)) {
+      std::string _words;
+      for (typ::entries::const_entry_ite _entry : _permutation) {
+        _words += _entry->get_word() + ' ';
+      }
+      if (!_drawn.insert(_words).second) {
+        TNCT_LOG_ERR("permutation ", _words, " drawn twice");
+        return false;
+      }
+    }
+    if (_drawn.size() != _random.count(p_num_words).value()) {
+      TNCT_LOG_ERR(_drawn.size(), " permutations drawn, but there are ",
+                   _random.count(p_num_words).value());
+      return false;
+    }
+    return true;
+  }
+};
+
+struct test_049 {
+  static std::string desc() {
+    return "Best first permutations are generated without repeats, the first "
+           "ones have all the words crossing a word before them, and "
+           "accented words are compared letter by letter";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    {
+      // 'pé' and 'ção' share no letter, although 'é', 'ç' and 'ã' start
+      // with the same byte in UTF-8
+      typ::entries _entries{{"pé", "expl pé"}, {"ção", "expl ção"}};
+      typ::permutation _sorted{make_sorted_permutation(_entries)};
+      bus::best_first_permutations _best_first;
+      _best_first.start(_sorted);
+      if (_best_first.estimate(_sorted) >= 0.0) {
+        TNCT_LOG_ERR("'pé' and 'ção' should not cross, but the estimate is ",
+                     _best_first.estimate(_sorted));
+        return false;
+      }
+    }
+
+    {
+      // 'casa' has 4 letters in 4 bytes, and 'ção' 3 letters in 5 bytes, so
+      // 'casa' is longer and preferred first
+      typ::entries _entries{{"casa", "expl casa"}, {"ção", "expl ção"}};
+      bus::best_first_permutations _best_first;
+      _best_first.start(make_sorted_permutation(_entries));
+      const auto _casa{std::find_if(_entries.begin(), _entries.end(),
+                                    [](const typ::entry &p_entry) {
+                                      return p_entry.get_word() == "casa";
+                                    })};
+      const auto _cao{_casa == _entries.begin() ? std::next(_entries.begin())
+                                                : _entries.begin()};
+      if (_best_first.estimate({_casa, _cao}) <=
+          _best_first.estimate({_cao, _casa})) {
+        TNCT_LOG_ERR("'casa' should be estimated as longer than 'ção'");
+        return false;
+      }
+    }
+
+    {
+      typ::entries _entries{{"ab", "expl ab"},
+                            {"bcd", "expl bcd"},
+                            {"xyzw", "expl xyzw"},
+                            {"dex", "expl dex"},
+                            {"wa", "expl wa"}};
+      bus::best_first_permutations _best_first;
+      _best_first.start(make_sorted_permutation(_entries));
+      std::set<typ::permutation> _drawn;
+      typ::permutation _permutation;
+      while (_best_first(_permutation)) {
+        if (!_drawn.insert(_permutation).second) {
+          TNCT_LOG_ERR("permutation ", _permutation, " generated twice");
+          return false;
+        }
+      }
+      if (_drawn.size() != 120) {
+        TNCT_LOG_ERR(_drawn.size(), " permutations generated, but there are "
+                                    "120");
+        return false;
+      }
+    }
+
+    typ::entries _entries{
+        {"afunilar", "expl afunilar"}, {"viravira", "expl viravira"},
+        {"badalar", "expl badalar"},   {"farelos", "expl farelos"},
+        {"lesante", "expl lesante"},   {"aguipa", "expl aguipa"},
+        {"debute", "expl debute"},     {"crepom", "expl crepom"},
+        {"idade", "expl idade"},       {"regis", "expl regis"}};
+    typ::permutation _sorted{make_sorted_permutation(_entries)};
+
+    bus::lexicographic_permutations _lexicographic;
+    _lexicographic.start(_sorted);
+    bus::best_first_permutations _best_first;
+    _best_first.start(_sorted);
+
+    size_t _lexicographic_connected{0};
+    size_t _best_first_connected{0};
+    typ::permutation _permutation;
+    for (size_t _i = 0; _i < 1000; ++_i) {
+      _lexicographic(_permutation);
+      _lexicographic_connected += connected(_permutation) ? 1 : 0;
+      _best_first(_permutation);
+      _best_first_connected += connected(_permutation) ? 1 : 0;
+    }
+    TNCT_LOG_TST("permutations with all the words crossing a word before "
+                 "them, out of 1000: ",
+                 _lexicographic_connected, " lexicographic, ",
+                 _best_first_connected, " best first");
+    if ((_best_first_connected != 1000) ||
+        (_lexicographic_connected == 1000)) {
+      return false;
+    }
+
+    bus::basic_assembler<typ::grid, bus::internal::organizer,
+                         bus::best_first_permutations>
+        _assembler(async::alg::dispatcher::create());
+    std::shared_ptr<typ::grid> _grid{
+        _assembler.start(_entries, typ::index{11}, typ::index{11}, 4, 1000)};
+    if (!_grid) {
+      TNCT_LOG_ERR("the assembler should organize the grid");
+      return false;
+    }
+    TNCT_LOG_TST("organized after ", _assembler.get_num_attempts(),
+                 " attempts", *_grid);
+    return true;
+  }
+
+private:
+  /// \brief If each word shares a letter with a word before it
+  static bool connected(const crosswords::typ::permutation &p_permutation) {
+    for (auto _word = std::next(p_permutation.begin());
+         _word != p_permutation.end(); ++_word) {
+      const crosswords::typ::word &_letters{(*_word)->get_word()};
+      if (std::none_of(
+              p_permutation.begin(), _word,
+              [&_letters](crosswords::typ::entries::const_entry_ite p_before) {
+                return p_before->get_word().find_first_of(_letters) !=
+                       crosswords::typ::word::npos;
+              })) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+struct test_050 {
+  static std::string desc() {
+    return "Clusters of up to 6 of 42 words are organized in sub-grids, which "
+           "are placed, connected, in a 16x16 grid, while the assembler tries "
+           "up to the maximum permutations given";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries;
+    for (const char *_word :
+         {"chat",    "crepom",   "debute",  "regis",   "gases",   "exumar",
+          "dias",    "pai",      "lesante", "ma",      "afunilar", "atoba",
+          "ot",      "viravira", "sideral", "gim",     "oval",    "rapina",
+          "lados",   "rotor",    "aresta",  "poxa",    "hexa",    "aguipa",
+          "tim",     "salutar",  "renovar", "eg",      "badalar", "usina",
+          "teatro",  "esse",     "sola",    "avivar",  "idade",   "farelos",
+          "st",      "sibliar",  "pop",     "agito",   "inox",    "tamara"}) {
+      _entries.add_entry(typ::word{_word}, "expl " + typ::word{_word});
+    }
+
+    // 42! permutations do not fit in 64 bits, so only the maximum given
+    // limits the assembler
+    bus::assembler _assembler(async::alg::dispatcher::create());
+    std::shared_ptr<typ::grid> _assembled{
+        _assembler.start(_entries, typ::index{16}, typ::index{16}, 4, 1000)};
+    if ((_assembler.get_num_attempts() == 0) ||
+        (_assembler.get_num_attempts() > 1000) ||
+        (_assembled && !_assembled->organized())) {
+      TNCT_LOG_ERR("the assembler should try up to 1000 permutations, but "
+                   "tried ",
+                   _assembler.get_num_attempts());
+      return false;
+    }
+
+    bus::clusterer _clusterer;
+    std::shared_ptr<typ::grid> _grid{
+        _clusterer.start(_entries, typ::index{16}, typ::index{16}, 4)};
+    if (!_grid || !_grid->organized()) {
+      TNCT_LOG_ERR("the clusterer should organize the grid");
+      return false;
+    }
+
+    std::set<size_t> _clustered;
+    for (const std::vector<size_t> &_cluster : _clusterer.get_clusters()) {
+      if (_cluster.size() > bus::clusterer::default_max_cluster_size) {
+        TNCT_LOG_ERR("cluster with ", _cluster.size(), " words");
+        return false;
+      }
+      _clustered.insert(_cluster.begin(), _cluster.end());
+    }
+    if (_clustered.size() != 42) {
+      TNCT_LOG_ERR("only ", _clustered.size(), " words in the clusters");
+      return false;
+    }
+
+    std::vector<typ::grid::const_layout_ite> _positioned;
+    for (auto _layout = _grid->begin(); _layout != _grid->end(); ++_layout) {
+      if (_grid->read(_layout) != _layout->get_letters()) {
+        TNCT_LOG_ERR("the cells of ", *_layout, " do not have its letters");
+        return false;
+      }
+      _positioned.push_back(_layout);
+    }
+
+    std::vector<bool> _reached(_positioned.size(), false);
+    std::vector<size_t> _queue{0};
+    _reached[0] = true;
+    for (size_t _next = 0; _next < _queue.size(); ++_next) {
+      for (size_t _i = 0; _i < _positioned.size(); ++_i) {
+        if (!_reached[_i] && bus::internal::touch<typ::grid>(
+                                 _positioned[_queue[_next]], _positioned[_i])) {
+          _reached[_i] = true;
+          _queue.push_back(_i);
+        }
+      }
+    }
+    if (_queue.size() != _positioned.size()) {
+      TNCT_LOG_ERR("only ", _queue.size(), " of the ", _positioned.size(),
+                   " words are connected");
+      return false;
+    }
+
+    TNCT_LOG_TST(_clusterer.get_clusters().size(), " clusters, ",
+                 _clusterer.get_num_splits(), " sub-grids split, ",
+                 _clusterer.get_num_stitches(), " placements", *_grid);
+    return true;
+  }
+};
+
+struct test_051 {
+  static std::string desc() {
+    return "A claim of cells that fails releases the cells claimed, and 4 "
+           "workers fill a 200x200 grid with 4000 words at the same time";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    {
+      bus::internal::claim_board _board{typ::index{4}, typ::index{4}};
+      if (!_board.claim("abc", 0, 0, typ::orientation::hori) ||
+          !_board.claim("bxy", 0, 1, typ::orientation::vert)) {
+        TNCT_LOG_ERR("words that share a letter should be positioned");
+        return false;
+      }
+      // 'q' is claimed, and released when 'b' does not match 'x'
+      if (_board.claim("qbz", 1, 0, typ::orientation::hori) ||
+          (_board.overlaps("w", 1, 0, typ::orientation::hori) != 0)) {
+        TNCT_LOG_ERR("the cells of a claim that failed should be released");
+        return false;
+      }
+      // inside "abc"
+      if (_board.claim("ab", 0, 0, typ::orientation::hori)) {
+        TNCT_LOG_ERR("a word inside another should not be positioned");
+        return false;
+      }
+    }
+
+    std::mt19937 _random{5};
+    typ::entries _entries;
+    for (size_t _i = 0; _i < 4000; ++_i) {
+      typ::word _word(4 + _random() % 7, 'a');
+      for (char &_letter : _word) {
+        _letter = static_cast<char>('a' + _random() % 8);
+      }
+      _entries.add_entry(std::move(_word), "expl");
+    }
+
+    bus::concurrent_filler _filler;
+    std::shared_ptr<typ::grid> _grid{
+        _filler.start(_entries, typ::index{200}, typ::index{200}, 4)};
+    if (!_grid) {
+      TNCT_LOG_ERR("the filler should create the grid");
+      return false;
+    }
+
+    size_t _positioned{0};
+    for (auto _layout = _grid->begin(); _layout != _grid->end(); ++_layout) {
+      if (!_layout->is_positioned()) {
+        continue;
+      }
+      ++_positioned;
+      if (_grid->read(_layout) != _layout->get_letters()) {
+        TNCT_LOG_ERR("the cells of ", *_layout, " do not have its letters");
+        return false;
+      }
+    }
+    TNCT_LOG_TST(_positioned, " of 4000 words positioned, with ",
+                 _filler.get_num_conflicts(), " claims failed");
+    return (_positioned == _filler.get_num_placed()) && (_positioned > 3600);
+  }
+};
+
+struct test_052 {
+  static std::string desc() {
+    return "A claim board of 20000x20000 cells only allocates the tiles "
+           "claimed, and 4 workers fill a sparse 1000x1000 grid with 20000 "
+           "words";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    {
+      bus::internal::claim_board _board{typ::index{20000},
+                                        typ::index{20000}};
+      if (!_board.claim("verso", 19999, 19990, typ::orientation::hori) ||
+          !_board.claim("avo", 19997, 19994, typ::orientation::vert) ||
+          (_board.overlaps("x", 0, 0, typ::orientation::hori) != 0)) {
+        TNCT_LOG_ERR("words should be positioned in the last cells");
+        return false;
+      }
+      if (_board.get_num_tiles() != 1) {
+        TNCT_LOG_ERR("1 tile should be allocated, but ",
+                     _board.get_num_tiles(), " were");
+        return false;
+      }
+    }
+
+    std::mt19937 _random{7};
+    typ::entries _entries;
+    for (size_t _i = 0; _i < 20000; ++_i) {
+      typ::word _word(4 + _random() % 7, 'a');
+      for (char &_letter : _word) {
+        _letter = static_cast<char>('a' + _random() % 20);
+      }
+      _entries.add_entry(std::move(_word), "expl");
+    }
+
+    bus::basic_concurrent_filler<typ::sparse_grid> _filler;
+    std::shared_ptr<typ::sparse_grid> _grid{
+        _filler.start(_entries, typ::index{1000}, typ::index{1000}, 4)};
+    if (!_grid) {
+      TNCT_LOG_ERR("the filler should create the grid");
+      return false;
+    }
+
+    size_t _positioned{0};
+    for (auto _layout = _grid->begin(); _layout != _grid->end(); ++_layout) {
+      if (!_layout->is_positioned()) {
+        continue;
+      }
+      ++_positioned;
+      if (_grid->read(_layout) != _layout->get_letters()) {
+        TNCT_LOG_ERR("the cells of ", *_layout, " do not have its letters");
+        return false;
+      }
+    }
+    TNCT_LOG_TST(_positioned, " of 20000 words positioned");
+    return (_positioned == _filler.get_num_placed()) && (_positioned > 19000);
+  }
+};
+
+struct test_053 {
+  static std::string desc() {
+    return "4 workers fill a 60x60 word search puzzle with 600 words, in the "
+           "8 orientations";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    std::mt19937 _random{11};
+    typ::entries _entries;
+    for (size_t _i = 0; _i < 600; ++_i) {
+      typ::word _word(4 + _random() % 5, 'a');
+      for (char &_letter : _word) {
+        _letter = static_cast<char>('a' + _random() % 6);
+      }
+      _entries.add_entry(std::move(_word), "expl");
+    }
+
+    bus::concurrent_filler _filler(
+        bus::concurrent_filler::default_max_tries,
+        {typ::all_orientations.begin(), typ::all_orientations.end()});
+    std::shared_ptr<typ::grid> _grid{
+        _filler.start(_entries, typ::index{60}, typ::index{60}, 4)};
+    if (!_grid) {
+      TNCT_LOG_ERR("the filler should create the grid");
+      return false;
+    }
+
+    std::set<typ::orientation> _orientations;
+    size_t _positioned{0};
+    for (auto _layout = _grid->begin(); _layout != _grid->end(); ++_layout) {
+      if (!_layout->is_positioned()) {
+        continue;
+      }
+      ++_positioned;
+      _orientations.insert(_layout->get_orientation());
+      if (_grid->read_letters(_layout) != _layout->get_letters()) {
+        TNCT_LOG_ERR("the cells of ", *_layout, " do not have its letters");
+        return false;
+      }
+    }
+    TNCT_LOG_TST(_positioned, " of 600 words positioned, in ",
+                 _orientations.size(), " orientations");
+    return (_positioned == _filler.get_num_placed()) && (_positioned > 580) &&
+           (_orientations.size() == typ::all_orientations.size());
+  }
+};
+
+struct test_054 {
+  static std::string desc() {
+    return "An assembler stopped while its organizers are still running "
+           "returns promptly";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    const typ::entries _entries{make_entries(std::vector<typ::word>{
+        all_words.begin(), std::next(all_words.begin(), 14)})};
+
+    using organizer = bus::internal::basic_backtracking_organizer<
+        typ::grid, bus::most_constrained_first>;
+    bus::basic_assembler<typ::grid, organizer> _assembler(
+        async::alg::dispatcher::create());
+
+    // the 4000 permutations are published before the stop, so the assembler
+    // is waiting for the organizers when it is stopped
+    std::chrono::steady_clock::time_point _stopped;
+    std::thread _stopper([&_assembler, &_stopped]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+      _stopped = std::chrono::steady_clock::now();
+      _assembler.stop();
+    });
+    _assembler.start(_entries, typ::index{9}, typ::index{9}, 2, 4000);
+    const auto _returned{std::chrono::steady_clock::now()};
+    _stopper.join();
+
+    const auto _delay{std::chrono::duration_cast<std::chrono::milliseconds>(
+        _returned - _stopped)};
+    TNCT_LOG_TST("assembler returned ", _delay.count(), " ms after stop");
+    return _delay < std::chrono::milliseconds(300);
+  }
+};
+
+struct test_055 {
+  static std::string desc() {
+    return "The first word positioner tries every place of the first word in a "
+           "'sparse_grid', horizontally and then vertically";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries{{"verso", "expl verso"}};
+    typ::permutation _permutation{_entries.begin()};
+    typ::sparse_grid _grid(_permutation, typ::index{6}, typ::index{10});
+
+    bus::internal::basic_first_word_positioner<typ::sparse_grid> _positioner;
+    std::atomic<bool> _stop{false};
+    size_t _horizontal{0};
+    size_t _vertical{0};
+    while (_positioner(_stop, _grid)) {
+      const typ::layout &_layout{*_grid.begin()};
+      if (_grid.read(_grid.begin()) != _layout.get_letters()) {
+        TNCT_LOG_ERR("'verso' should be read at ", _layout);
+        return false;
+      }
+      if (_layout.get_orientation() == typ::orientation::hori) {
+        if (_vertical != 0) {
+          TNCT_LOG_ERR("horizontal place after a vertical one: ", _layout);
+          return false;
+        }
+        ++_horizontal;
+      } else {
+        ++_vertical;
+      }
+      _grid.unset(_grid.begin());
+    }
+    TNCT_LOG_TST(_horizontal, " horizontal and ", _vertical,
+                 " vertical places");
+    // 6 columns in each of the 6 rows, and 2 rows in each of the 10 columns
+    return (_horizontal == 6 * 6) && (_vertical == 2 * 10);
+  }
+};
+
 int main(int argc, char **argv) {
   log::alg::set_debug_level();
   //  log::alg::set_file_writer("crosswords");
@@ -1449,4 +3105,28 @@ int main(int argc, char **argv) {
   run_test(_tester, test_029);
   run_test(_tester, test_030);
   run_test(_tester, test_031);
+  run_test(_tester, test_032);
+  run_test(_tester, test_033);
+  run_test(_tester, test_034);
+  run_test(_tester, test_035);
+  run_test(_tester, test_036);
+  run_test(_tester, test_037);
+  run_test(_tester, test_038);
+  run_test(_tester, test_039);
+  run_test(_tester, test_040);
+  run_test(_tester, test_041);
+  run_test(_tester, test_042);
+  run_test(_tester, test_043);
+  run_test(_tester, test_044);
+  run_test(_tester, test_045);
+  run_test(_tester, test_046);
+  run_test(_tester, test_047);
+  run_test(_tester, test_048);
+  run_test(_tester, test_049);
+  run_test(_tester, test_050);
+  run_test(_tester, test_051);
+  run_test(_tester, test_052);
+  run_test(_tester, test_053);
+  run_test(_tester, test_054);
+  run_test(_tester, test_055);
 }
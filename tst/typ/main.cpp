@@ -3,11 +3,19 @@
 
 /// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <iterator>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include <tenacitas.lib.crosswords/typ/grid.h>
+#include <tenacitas.lib.crosswords/typ/nogood_store.h>
+#include <tenacitas.lib.crosswords/typ/transposition_table.h>
 #include <tenacitas.lib.log/alg/logger.h>
 #include <tenacitas.lib.program/alg/options.h>
 #include <tenacitas.lib.test/alg/tester.h>
@@ -112,6 +120,854 @@ struct test_002 {
   }
 };
 
+struct test_003 {
+  static std::string desc() {
+    return "'bitboard' checking free and compatible spans across blocks";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::alphabet _alphabet;
+    _alphabet.add("denop");
+    typ::bitboard _bitboard(typ::index{70}, typ::index{70}, _alphabet.size());
+
+    // 'open' horizontally at row 3, crossing the border between blocks
+    typ::index _col{62};
+    for (typ::letter _letter : _alphabet.encode("open")) {
+      _bitboard.occupy(typ::index{3}, _col++, _letter);
+    }
+
+    if (!_bitboard.is_free_horizontally(typ::index{3}, typ::index{0}, typ::index{62})) {
+      TNCT_LOG_ERR("cells before 'open' should be free");
+      return false;
+    }
+    if (_bitboard.is_free_horizontally(typ::index{3}, typ::index{60}, typ::index{3})) {
+      TNCT_LOG_ERR("cell 62 should be occupied");
+      return false;
+    }
+    if (!_bitboard.is_free_vertically(typ::index{4}, typ::index{64}, typ::index{5})) {
+      TNCT_LOG_ERR("column 64 below row 3 should be free");
+      return false;
+    }
+
+    // 'one' vertically at column 64 crosses 'open' at its 'e'
+    if (!_bitboard.fits_vertically(typ::index{1}, typ::index{64}, typ::index{3},
+                                   _bitboard.masks(_alphabet.encode("one")))) {
+      TNCT_LOG_ERR("'one' should fit vertically at (1,64)");
+      return false;
+    }
+    if (_bitboard.fits_vertically(typ::index{2}, typ::index{64}, typ::index{3},
+                                  _bitboard.masks(_alphabet.encode("one")))) {
+      TNCT_LOG_ERR("'one' should not fit vertically at (2,64)");
+      return false;
+    }
+
+    // 'dopen' horizontally overlapping 'open' exactly
+    if (!_bitboard.fits_horizontally(typ::index{3}, typ::index{61}, typ::index{5},
+                                     _bitboard.masks(_alphabet.encode("dopen")))) {
+      TNCT_LOG_ERR("'dopen' should fit horizontally at (3,61)");
+      return false;
+    }
+    if (_bitboard.fits_horizontally(typ::index{3}, typ::index{60}, typ::index{5},
+                                    _bitboard.masks(_alphabet.encode("dopen")))) {
+      TNCT_LOG_ERR("'dopen' should not fit horizontally at (3,60)");
+      return false;
+    }
+
+    return true;
+  }
+};
+
+struct test_004 {
+  static std::string desc() {
+    return "'grid' fit checks with and without letter bitboards agree";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+    typ::entries _entries{
+        {"open", "expl 1"}, {"never", "expl 2"}, {"extra", "expl 3"}};
+
+    typ::entries::const_entry_ite _begin{_entries.begin()};
+
+    typ::permutation _permutation;
+    _permutation.push_back(std::next(_begin, 0));
+    _permutation.push_back(std::next(_begin, 1));
+    _permutation.push_back(std::next(_begin, 2));
+
+    typ::grid _with(_permutation, typ::index{9}, typ::index{9}, 0, true);
+    typ::grid _without(_permutation, typ::index{9}, typ::index{9}, 0, false);
+
+    _with.set(_with.begin(), typ::index{2}, typ::index{1},
+              typ::orientation::hori);
+    _without.set(_without.begin(), typ::index{2}, typ::index{1},
+                 typ::orientation::hori);
+
+    for (typ::index _row = 0; _row < 9; ++_row) {
+      for (typ::index _col = 0; _col < 9; ++_col) {
+        for (auto _layout = std::next(_with.begin());
+             _layout != _with.end(); ++_layout) {
+          const auto _size{typ::get_size(_layout->get_word())};
+          auto _other{std::next(
+              _without.begin(), std::distance(_with.begin(), _layout))};
+          if ((_col + _size <= 9) &&
+              (_with.fits_horizontally(_row, _col, _layout) !=
+               _without.fits_horizontally(_row, _col, _other))) {
+            TNCT_LOG_ERR("horizontal fit differs for '", _layout->get_word(),
+                         "' at (", _row, ',', _col, ')');
+            return false;
+          }
+          if ((_row + _size <= 9) &&
+              (_with.fits_vertically(_row, _col, _layout) !=
+               _without.fits_vertically(_row, _col, _other))) {
+            TNCT_LOG_ERR("vertical fit differs for '", _layout->get_word(),
+                         "' at (", _row, ',', _col, ')');
+            return false;
+          }
+        }
+      }
+    }
+
+    // 'never' crosses 'open' at its 'e', at (2,3)
+    return _with.fits_vertically(typ::index{1}, typ::index{3},
+                                 std::next(_with.begin())) &&
+           !_with.fits_vertically(typ::index{2}, typ::index{3},
+                                  std::next(_with.begin()));
+  }
+};
+
+struct test_005 {
+  static std::string desc() {
+    return "'simd::fits' agrees with a letter by letter comparison";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    const char _empty{typ::max_char};
+    std::string _cells;
+    std::string _word;
+    for (size_t _size = 1; _size <= 70; ++_size) {
+      for (size_t _conflict = 0; _conflict <= _size; ++_conflict) {
+        _cells.assign(_size, _empty);
+        _word.assign(_size, 'a');
+        for (size_t _i = 0; _i < _size; _i += 3) {
+          _cells[_i] = 'a';
+        }
+        if (_conflict < _size) {
+          _cells[_conflict] = 'b';
+        }
+        bool _expected{true};
+        for (size_t _i = 0; _i < _size; ++_i) {
+          if ((_cells[_i] != _empty) && (_cells[_i] != _word[_i])) {
+            _expected = false;
+          }
+        }
+        if (typ::simd::fits(_cells.data(), _word.data(), _size, _empty) !=
+            _expected) {
+          TNCT_LOG_ERR("wrong result for size ", _size, " and conflict at ",
+                       _conflict);
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+struct test_006 {
+  static std::string desc() {
+    return "Vertical fit checks reading cells with a stride of one row, and "
+           "reading the contiguous column-major copy, give the same results";
+  }
+
+  bool operator()(const program::alg::options &) {
+    return compare(11) && compare(25) && compare(101);
+  }
+
+private:
+  bool compare(crosswords::typ::index p_size) {
+    using namespace crosswords;
+
+    const typ::index _word_size{static_cast<typ::index>(p_size / 2 + 1)};
+    typ::word _word;
+    for (typ::index _i = 0; _i < _word_size; ++_i) {
+      _word.push_back(static_cast<char>('a' + (_i % 5)));
+    }
+    typ::entries _entries{{"abcde", "filler"}, {typ::word{_word}, "checked"}};
+    typ::permutation _permutation{_entries.begin(),
+                                  std::next(_entries.begin())};
+    typ::grid _grid(_permutation, p_size, p_size);
+
+    // fills some cells of the first two thirds of the columns, leaving the
+    // other columns free
+    const typ::index _filled_cols{static_cast<typ::index>(p_size * 2 / 3)};
+    for (typ::index _row = 0; _row < p_size; _row += 3) {
+      for (typ::index _col = (_row % 7); _col + 5 <= _filled_cols; _col += 9) {
+        _grid.set(_grid.begin(), _row, _col, typ::orientation::hori);
+      }
+    }
+
+    const auto _checked{std::next(_grid.begin())};
+    const typ::index _last_row{static_cast<typ::index>(p_size - _word_size)};
+    const size_t _num_spans{static_cast<size_t>(p_size) *
+                            static_cast<size_t>(_last_row + 1)};
+    const int _loops{1000000 / (p_size * p_size) + 1};
+
+    // both read paths compare every cell, without the free span fast path of
+    // the bitboard, so only the way the cells are read differs
+    std::vector<uint8_t> _strided_fits(_num_spans, 0);
+    auto _start{std::chrono::high_resolution_clock::now()};
+    for (int _loop = 0; _loop < _loops; ++_loop) {
+      size_t _span{0};
+      for (typ::index _col = 0; _col < p_size; ++_col) {
+        for (typ::index _row = 0; _row <= _last_row; ++_row) {
+          bool _fits{true};
+          typ::index _count{0};
+          for (typ::letter _letter : _checked->get_letters()) {
+            const auto _maybe{_grid.is_occupied(_row + _count++, _col)};
+            if (_maybe && (_maybe.value() != _letter)) {
+              _fits = false;
+              break;
+            }
+          }
+          _strided_fits[_span++] = _fits;
+        }
+      }
+    }
+    std::chrono::duration<double> _strided{
+        std::chrono::high_resolution_clock::now() - _start};
+
+    std::vector<uint8_t> _contiguous_fits(_num_spans, 0);
+    const typ::letters &_letters{_checked->get_padded_letters()};
+    _start = std::chrono::high_resolution_clock::now();
+    for (int _loop = 0; _loop < _loops; ++_loop) {
+      size_t _span{0};
+      for (typ::index _col = 0; _col < p_size; ++_col) {
+        const std::string_view _cells{_grid.get_col(_col)};
+        for (typ::index _row = 0; _row <= _last_row; ++_row) {
+          _contiguous_fits[_span++] = typ::simd::fits_padded(
+              _cells.data() + _row, _letters.data(),
+              static_cast<size_t>(_word_size), typ::max_char);
+        }
+      }
+    }
+    std::chrono::duration<double> _contiguous{
+        std::chrono::high_resolution_clock::now() - _start};
+
+    TNCT_LOG_TST(p_size, 'x', p_size, " grid, word with ", _word_size,
+                 " letters, ", _loops, " loops: strided = ", _strided.count(),
+                 "s, contiguous = ", _contiguous.count(), 's');
+
+    size_t _span{0};
+    size_t _num_fits{0};
+    for (typ::index _col = 0; _col < p_size; ++_col) {
+      for (typ::index _row = 0; _row <= _last_row; ++_row, ++_span) {
+        const bool _fits{_grid.fits_vertically(_row, _col, _checked)};
+        if ((_strided_fits[_span] != _fits) ||
+            (_contiguous_fits[_span] != _fits)) {
+          TNCT_LOG_ERR("at ", _row, ',', _col, " strided says ",
+                       int{_strided_fits[_span]}, ", contiguous says ",
+                       int{_contiguous_fits[_span]}, ", but it ",
+                       (_fits ? "fits" : "does not fit"));
+          return false;
+        }
+        _num_fits += _fits;
+      }
+    }
+
+    // the filling must leave spans where the word fits and spans where it
+    // does not, or the comparison proves nothing
+    if ((_num_fits == 0) || (_num_fits == _num_spans)) {
+      TNCT_LOG_ERR("the word fits in ", _num_fits, " of ", _num_spans,
+                   " spans");
+      return false;
+    }
+    return true;
+  }
+};
+
+struct test_007 {
+  static std::string desc() {
+    return "Reading a vertical 'layout' from the column-major copy";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+    typ::entries _entries{{"open", "expl 1"}, {"never", "expl 2"}};
+
+    typ::permutation _permutation{_entries.begin(),
+                                  std::next(_entries.begin())};
+
+    typ::grid _grid(_permutation, typ::index{7}, typ::index{11});
+
+    _grid.set(_grid.begin(), typ::index{0}, typ::index{4},
+              typ::orientation::vert);
+    _grid.set(std::next(_grid.begin()), typ::index{2}, typ::index{3},
+              typ::orientation::hori);
+
+    TNCT_LOG_TST(_grid);
+
+    const typ::alphabet &_alphabet{_grid.get_alphabet()};
+    return (_alphabet.decode(_grid.read(_grid.begin())) == "open") &&
+           (_alphabet.decode(_grid.read(std::next(_grid.begin()))) ==
+            "never") &&
+           (_alphabet.decode(_grid.get_col(typ::index{4}).substr(0, 4)) ==
+            "open") &&
+           (_alphabet.decode(_grid.get_row(typ::index{2}).substr(3, 5)) ==
+            "never");
+  }
+};
+
+struct test_008 {
+  static std::string desc() {
+    return "Words with accented letters are coded one letter per cell";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+    typ::entries _entries{{"ação", "expl 1"}, {"pão", "expl 2"}};
+
+    typ::permutation _permutation{_entries.begin(),
+                                  std::next(_entries.begin())};
+
+    typ::grid _grid(_permutation, typ::index{4}, typ::index{4});
+
+    const typ::alphabet &_alphabet{_grid.get_alphabet()};
+    if (_alphabet.size() != 5) {
+      TNCT_LOG_ERR("alphabet should have 5 letters, but it has ",
+                   _alphabet.size());
+      return false;
+    }
+
+    if ((_grid.begin()->get_size() != 4) ||
+        (std::next(_grid.begin())->get_size() != 3)) {
+      TNCT_LOG_ERR("sizes should be counted in letters, not in bytes");
+      return false;
+    }
+
+    // 'pão' vertically crosses 'ação' at its 'ã'
+    _grid.set(_grid.begin(), typ::index{1}, typ::index{0},
+              typ::orientation::hori);
+    if (!_grid.fits_vertically(typ::index{0}, typ::index{2},
+                               std::next(_grid.begin()))) {
+      TNCT_LOG_ERR("'pão' should fit vertically at (0,2)");
+      return false;
+    }
+    if (_grid.fits_vertically(typ::index{0}, typ::index{1},
+                              std::next(_grid.begin()))) {
+      TNCT_LOG_ERR("'pão' should not fit vertically at (0,1)");
+      return false;
+    }
+    _grid.set(std::next(_grid.begin()), typ::index{0}, typ::index{2},
+              typ::orientation::vert);
+
+    TNCT_LOG_TST(_grid);
+
+    return (_alphabet.decode(_grid.read(_grid.begin())) == "ação") &&
+           (_alphabet.decode(_grid.read(std::next(_grid.begin()))) == "pão") &&
+           (_alphabet.decode(_grid.get_col(typ::index{2}).substr(0, 3)) ==
+            "pão");
+  }
+};
+
+struct test_009 {
+  static std::string desc() {
+    return "'fixed_grid' places and prints words as 'grid' does, and refuses "
+           "other dimensions";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+    typ::entries _entries{
+        {"open", "expl 1"}, {"never", "expl 2"}, {"extra", "expl 3"}};
+
+    typ::permutation _permutation{_entries.begin(),
+                                  std::next(_entries.begin()),
+                                  std::next(_entries.begin(), 2)};
+
+    typ::grid _dynamic(_permutation, typ::index{11}, typ::index{11});
+    typ::fixed_grid<11, 11> _fixed(_permutation, typ::index{11},
+                                   typ::index{11});
+
+    _dynamic.set(_dynamic.begin(), typ::index{2}, typ::index{1},
+                 typ::orientation::hori);
+    _fixed.set(_fixed.begin(), typ::index{2}, typ::index{1},
+               typ::orientation::hori);
+
+    for (typ::index _row = 0; _row < 11; ++_row) {
+      for (typ::index _col = 0; _col + 5 <= 11; ++_col) {
+        const auto _layout{std::next(_dynamic.begin())};
+        const auto _other{std::next(_fixed.begin())};
+        if ((_dynamic.fits_horizontally(_row, _col, _layout) !=
+             _fixed.fits_horizontally(_row, _col, _other)) ||
+            (_dynamic.fits_vertically(_col, _row, _layout) !=
+             _fixed.fits_vertically(_col, _row, _other))) {
+          TNCT_LOG_ERR("fit differs at (", _row, ',', _col, ')');
+          return false;
+        }
+      }
+    }
+
+    _dynamic.set(std::next(_dynamic.begin()), typ::index{1}, typ::index{3},
+                 typ::orientation::vert);
+    _fixed.set(std::next(_fixed.begin()), typ::index{1}, typ::index{3},
+               typ::orientation::vert);
+
+    std::stringstream _dynamic_out;
+    std::stringstream _fixed_out;
+    _dynamic_out << _dynamic;
+    _fixed_out << _fixed;
+    TNCT_LOG_TST(_fixed);
+    if (_dynamic_out.str() != _fixed_out.str()) {
+      TNCT_LOG_ERR("grids should be printed the same way");
+      return false;
+    }
+
+    try {
+      typ::fixed_grid<11, 11> _wrong(_permutation, typ::index{13},
+                                     typ::index{13});
+      TNCT_LOG_ERR("'fixed_grid<11, 11>' should not be created as 13x13");
+      return false;
+    } catch (std::exception &_ex) {
+      TNCT_LOG_TST("as expected: ", _ex.what());
+    }
+    return true;
+  }
+};
+
+struct test_010 {
+  static std::string desc() {
+    return "'unset' frees the cells of a word, except the ones crossed by "
+           "another word";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+    typ::entries _entries{{"open", "expl 1"}, {"never", "expl 2"}};
+
+    typ::permutation _permutation{_entries.begin(),
+                                  std::next(_entries.begin())};
+
+    typ::grid _grid(_permutation, typ::index{7}, typ::index{11});
+
+    _grid.set(_grid.begin(), typ::index{0}, typ::index{4},
+              typ::orientation::vert);
+    _grid.set(std::next(_grid.begin()), typ::index{2}, typ::index{3},
+              typ::orientation::hori);
+
+    _grid.unset(std::next(_grid.begin()));
+    TNCT_LOG_TST(_grid);
+
+    if (std::next(_grid.begin())->is_positioned()) {
+      TNCT_LOG_ERR("'never' should not be positioned");
+      return false;
+    }
+    for (typ::index _col = 3; _col < 8; ++_col) {
+      if ((_col != 4) && _grid.is_occupied(typ::index{2}, _col)) {
+        TNCT_LOG_ERR("cell (2,", _col, ") should be free");
+        return false;
+      }
+    }
+    if (!_grid.is_occupied(typ::index{2}, typ::index{4})) {
+      TNCT_LOG_ERR("cell (2,4) is used by 'open', and should be occupied");
+      return false;
+    }
+    // (2,6) had the second 'e' of 'never', and now accepts its 'v'
+    return _grid.fits_vertically(typ::index{0}, typ::index{6},
+                                 std::next(_grid.begin())) &&
+           !_grid.fits_horizontally(typ::index{2}, typ::index{2},
+                                    std::next(_grid.begin())) &&
+           (_grid.get_alphabet().decode(_grid.get_col(typ::index{4}).substr(
+                0, 4)) == "open");
+  }
+};
+
+struct test_011 {
+  static std::string desc() {
+    return "Keys inserted in a 'nogood_store' by many threads are all found, "
+           "and the store does not grow beyond its capacity";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::nogood_store _store{1 << 14};
+
+    const typ::nogood_store::key _key{typ::nogood_store::position_key(
+        7, typ::index{2}, typ::index{3}, typ::orientation::hori)};
+    if (_key == typ::nogood_store::position_key(7, typ::index{3},
+                                                typ::index{2},
+                                                typ::orientation::hori)) {
+      TNCT_LOG_ERR("positions with row and column swapped have the same key");
+      return false;
+    }
+
+    std::vector<std::thread> _threads;
+    for (uint64_t _thread = 0; _thread < 4; ++_thread) {
+      _threads.emplace_back([&_store, _thread]() {
+        for (uint64_t _i = 0; _i < 500; ++_i) {
+          _store.insert(typ::nogood_store::position_key(
+              _thread * 1000 + _i, typ::index{0}, typ::index{0},
+              typ::orientation::vert));
+        }
+      });
+    }
+    for (std::thread &_thread : _threads) {
+      _thread.join();
+    }
+
+    if (_store.size() != 2000) {
+      TNCT_LOG_ERR("there should be 2000 keys, but there are ", _store.size());
+      return false;
+    }
+    for (uint64_t _word = 0; _word < 4000; _word += 1000) {
+      for (uint64_t _i = 0; _i < 500; ++_i) {
+        if (!_store.contains(typ::nogood_store::position_key(
+                _word + _i, typ::index{0}, typ::index{0},
+                typ::orientation::vert))) {
+          TNCT_LOG_ERR("key of word ", _word + _i, " not found");
+          return false;
+        }
+      }
+    }
+    if (_store.contains(_key)) {
+      TNCT_LOG_ERR("key never inserted was found");
+      return false;
+    }
+
+    for (uint64_t _i = 0; _i < 40000; ++_i) {
+      _store.insert(typ::nogood_store::position_key(
+          _i, typ::index{1}, typ::index{1}, typ::orientation::hori));
+    }
+    TNCT_LOG_TST("keys kept: ", _store.size(), ", capacity: ",
+                 _store.capacity());
+    return _store.size() <= _store.capacity();
+  }
+};
+
+struct test_012 {
+  static std::string desc() {
+    return "The hash of a grid depends on the words and their places, not on "
+           "the order they were positioned";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+    typ::entries _entries{{"open", "expl 1"}, {"never", "expl 2"}};
+
+    typ::permutation _permutation{_entries.begin(),
+                                  std::next(_entries.begin())};
+    typ::permutation _reversed{std::next(_entries.begin()),
+                               _entries.begin()};
+
+    typ::grid _first(_permutation, typ::index{7}, typ::index{11});
+    typ::grid _second(_reversed, typ::index{7}, typ::index{11});
+    if ((_first.get_hash() != 0) || (_second.get_hash() != 0)) {
+      TNCT_LOG_ERR("grids with no word positioned should have hash 0");
+      return false;
+    }
+
+    // 'open' first in one grid, 'never' first in the other
+    _first.set(_first.begin(), typ::index{0}, typ::index{4},
+               typ::orientation::vert);
+    _first.set(std::next(_first.begin()), typ::index{2}, typ::index{3},
+               typ::orientation::hori);
+    _second.set(_second.begin(), typ::index{2}, typ::index{3},
+                typ::orientation::hori);
+    _second.set(std::next(_second.begin()), typ::index{0}, typ::index{4},
+                typ::orientation::vert);
+    if (_first.get_hash() != _second.get_hash()) {
+      TNCT_LOG_ERR("grids with the same words at the same places should have "
+                   "the same hash");
+      return false;
+    }
+
+    const uint64_t _both{_first.get_hash()};
+    _first.unset(std::next(_first.begin()));
+    const uint64_t _open{_first.get_hash()};
+    _first.set(std::next(_first.begin()), typ::index{2}, typ::index{3},
+               typ::orientation::hori);
+    if ((_open == _both) || (_first.get_hash() != _both)) {
+      TNCT_LOG_ERR("'unset' and 'set' should update the hash");
+      return false;
+    }
+
+    _second.reset_positions();
+    return _second.get_hash() == 0;
+  }
+};
+
+struct test_013 {
+  static std::string desc() {
+    return "A full bucket of a 'transposition_table' keeps the grids with "
+           "more words to position";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    // memory for only one bucket, so all the keys go to the same bucket
+    typ::transposition_table _table{1};
+    if (_table.capacity() != typ::transposition_table::bucket_size) {
+      TNCT_LOG_ERR("capacity should be ", typ::transposition_table::bucket_size,
+                   ", but it is ", _table.capacity());
+      return false;
+    }
+
+    for (uint64_t _key = 1; _key <= 4; ++_key) {
+      _table.store(_key, static_cast<typ::transposition_table::depth>(_key + 4));
+    }
+    for (uint64_t _key = 1; _key <= 4; ++_key) {
+      if (!_table.failed(_key)) {
+        TNCT_LOG_ERR("key ", _key, " should be in the table");
+        return false;
+      }
+    }
+
+    // lower than all the depths in the bucket, so it is not kept
+    _table.store(10, 2);
+    if (_table.failed(10)) {
+      TNCT_LOG_ERR("key 10 should not be kept");
+      return false;
+    }
+
+    // replaces key 1, that has the lowest depth
+    _table.store(11, 20);
+    if (!_table.failed(11) || _table.failed(1)) {
+      TNCT_LOG_ERR("key 11 should have replaced key 1");
+      return false;
+    }
+    return _table.failed(2) && _table.failed(3) && _table.failed(4);
+  }
+};
+
+struct test_014 {
+  static std::string desc() {
+    return "'entries' counts more than 255 entries, and a 'sparse_grid' with "
+           "40000 columns only allocates the lines used";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries;
+    for (size_t _i = 0; _i < 300; ++_i) {
+      _entries.add_entry("w" + std::to_string(_i), "expl");
+    }
+    if (_entries.get_num_entries() != 300) {
+      TNCT_LOG_ERR("300 entries, but ", _entries.get_num_entries(),
+                   " were counted");
+      return false;
+    }
+
+    typ::lazy_cells _cells{4, 10, typ::max_char};
+    // only the non const access allocates a line
+    const typ::lazy_cells &_read{_cells};
+    if ((_read[35] != typ::max_char) || (_cells.get_num_allocated() != 0)) {
+      TNCT_LOG_ERR("reading a cell should not allocate its line");
+      return false;
+    }
+    _cells[35] = 'x';
+    if ((_read[35] != 'x') || (_read[34] != typ::max_char) ||
+        (_cells.get_num_allocated() != 1)) {
+      TNCT_LOG_ERR("writing a cell should allocate only its line");
+      return false;
+    }
+    _cells.release();
+    if ((_read[35] != typ::max_char) || (_cells.get_num_allocated() != 0)) {
+      TNCT_LOG_ERR("releasing should free all the lines");
+      return false;
+    }
+
+    typ::entries _words{{"verso", "expl verso"}, {"ovo", "expl ovo"}};
+    typ::permutation _permutation{_words.begin(), std::next(_words.begin())};
+    typ::sparse_grid _grid(_permutation, typ::index{6}, typ::index{40000});
+    const typ::index _col{39990};
+    _grid.set(_grid.begin(), typ::index{1}, _col, typ::orientation::hori);
+    if (_grid.read(_grid.begin()) != _grid.begin()->get_letters()) {
+      TNCT_LOG_ERR("'verso' should be read at column ", _col);
+      return false;
+    }
+    // 'ovo' crossing the 'o' of 'verso'
+    const auto _ovo{std::next(_grid.begin())};
+    if (!_grid.fits_vertically(typ::index{1}, _col + 4, _ovo) ||
+        _grid.fits_vertically(typ::index{1}, _col + 3, _ovo)) {
+      TNCT_LOG_ERR("'ovo' should only fit crossing the 'o' of 'verso'");
+      return false;
+    }
+    _grid.set(_ovo, typ::index{1}, _col + 4, typ::orientation::vert);
+    if ((_grid.read(_ovo) != _ovo->get_letters()) ||
+        !_grid.is_occupied(typ::index{2}, _col + 4) ||
+        _grid.is_occupied(typ::index{2}, _col + 3)) {
+      TNCT_LOG_ERR("'ovo' should be positioned");
+      return false;
+    }
+    _grid.unset(_ovo);
+    return !_grid.is_occupied(typ::index{2}, _col + 4) &&
+           _grid.is_occupied(typ::index{1}, _col + 4);
+  }
+};
+
+struct test_015 {
+  static std::string desc() {
+    return "A word is positioned, read and removed in all the 8 orientations, "
+           "and only fits where the cells are free or have its letters";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _words{{"bola", "expl bola"}, {"ala", "expl ala"}};
+    typ::permutation _permutation{_words.begin(), std::next(_words.begin())};
+    typ::grid _grid(_permutation, typ::index{5}, typ::index{5});
+    const auto _bola{_grid.begin()};
+    const auto _ala{std::next(_grid.begin())};
+
+    // from the center, 'bola' is inside the grid in all the orientations
+    for (typ::orientation _orientation : typ::all_orientations) {
+      if (!_grid.is_inside(2, 2, _orientation, 3) ||
+          _grid.is_inside(2, 2, _orientation, 4) ||
+          !_grid.fits(2, 2, _orientation, _ala)) {
+        TNCT_LOG_ERR("'ala' should be inside, and fit, at (2,2,",
+                     _orientation, ')');
+        return false;
+      }
+      _grid.set(_ala, 2, 2, _orientation);
+      if (_grid.read_letters(_ala) != _ala->get_letters()) {
+        TNCT_LOG_ERR("'ala' should be read at ", *_ala);
+        return false;
+      }
+      _grid.unset(_ala);
+      for (typ::index _row = 0; _row < _grid.get_num_rows(); ++_row) {
+        for (typ::index _col = 0; _col < _grid.get_num_cols(); ++_col) {
+          if (_grid.is_occupied(_row, _col)) {
+            TNCT_LOG_ERR("the grid should be empty after removing 'ala' at ",
+                         _orientation);
+            return false;
+          }
+        }
+      }
+    }
+
+    // 'bola' going down and right from (0,0) puts an 'a' at (3,3)
+    _grid.set(_bola, 0, 0, typ::orientation::diag);
+    if (!_grid.read(_bola).empty() ||
+        (_grid.read_letters(_bola) != _bola->get_letters())) {
+      TNCT_LOG_ERR("'bola' should only be read with 'read_letters'");
+      return false;
+    }
+    // 'ala' going left from (3,3) shares the 'a', but going up from (4,2),
+    // or up and right from (4,0), would put its last 'a' over the 'l' of
+    // 'bola', and going up and left from (4,4) would put its 'l' over the 'a'
+    if (!_grid.fits(3, 3, typ::orientation::hori_back, _ala) ||
+        _grid.fits(4, 2, typ::orientation::vert_back, _ala) ||
+        _grid.fits(4, 0, typ::orientation::anti_diag_back, _ala) ||
+        _grid.fits(4, 4, typ::orientation::diag_back, _ala) ||
+        !_grid.fits(1, 4, typ::orientation::anti_diag, _ala)) {
+      TNCT_LOG_ERR("'ala' should only fit where the cells are free or have "
+                   "its letters");
+      return false;
+    }
+    _grid.set(_ala, 3, 3, typ::orientation::hori_back);
+    _grid.unset(_ala);
+    return _grid.is_occupied(3, 3) && !_grid.is_occupied(3, 2) &&
+           (_grid.read_letters(_bola) == _bola->get_letters());
+  }
+};
+
+struct test_016 {
+  static std::string desc() {
+    return "A set of positions kept in a 'nogood_store' is found in any set "
+           "with all its positions, and only in those";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::nogood_store _store{1 << 10};
+
+    // positions of 6 words, in increasing order of their keys
+    std::vector<typ::nogood_store::key> _keys;
+    for (uint64_t _word = 0; _word < 6; ++_word) {
+      _keys.push_back(typ::nogood_store::position_key(
+          _word, typ::index{1}, static_cast<typ::index>(_word),
+          typ::orientation::hori));
+    }
+    std::sort(_keys.begin(), _keys.end());
+
+    const typ::nogood_store::key _base{11};
+    const std::vector<typ::nogood_store::key> _kept{_keys[1], _keys[3],
+                                                    _keys[4]};
+    _store.insert_set(_base, _kept.begin(), _kept.end());
+
+    if (!_store.contains_subset(_base, _kept.begin(), _kept.end()) ||
+        !_store.contains_subset(_base, _keys.begin(), _keys.end())) {
+      TNCT_LOG_ERR("set kept should be found in itself, and in all positions");
+      return false;
+    }
+    const std::vector<typ::nogood_store::key> _missing{_keys[0], _keys[1],
+                                                       _keys[3], _keys[5]};
+    if (_store.contains_subset(_base, _missing.begin(), _missing.end())) {
+      TNCT_LOG_ERR("set kept found in a set without one of its positions");
+      return false;
+    }
+    if (_store.contains_subset(_base + 1, _keys.begin(), _keys.end())) {
+      TNCT_LOG_ERR("set kept found with another base key");
+      return false;
+    }
+    // the prefixes are not sets kept
+    const std::vector<typ::nogood_store::key> _prefix{_keys[1], _keys[3]};
+    return !_store.contains_subset(_base, _prefix.begin(), _prefix.end());
+  }
+};
+
+struct test_017 {
+  static std::string desc() {
+    return "A cell of a 'grid' and of a 'sparse_grid' used by 300 words is "
+           "only freed when the last of them is removed";
+  }
+
+  bool operator()(const program::alg::options &) {
+    using namespace crosswords;
+
+    typ::entries _entries;
+    for (size_t _i = 0; _i < 300; ++_i) {
+      _entries.add_entry("ab", "expl " + std::to_string(_i));
+    }
+    typ::permutation _permutation;
+    for (auto _entry = _entries.begin(); _entry != _entries.end(); ++_entry) {
+      _permutation.push_back(_entry);
+    }
+
+    return shared_cell(typ::grid{_permutation, typ::index{2}, typ::index{2}}) &&
+           shared_cell(
+               typ::sparse_grid{_permutation, typ::index{2}, typ::index{2}});
+  }
+
+private:
+  template <typename t_grid> static bool shared_cell(t_grid p_grid) {
+    using namespace crosswords;
+
+    for (auto _layout = p_grid.begin(); _layout != p_grid.end(); ++_layout) {
+      p_grid.set(_layout, 0, 0, typ::orientation::hori);
+    }
+    auto _last{std::prev(p_grid.end())};
+    for (auto _layout = p_grid.begin(); _layout != _last; ++_layout) {
+      p_grid.unset(_layout);
+      if (!p_grid.is_occupied(0, 0)) {
+        TNCT_LOG_ERR("cell freed after removing ",
+                     std::distance(p_grid.begin(), _layout) + 1,
+                     " of 300 words");
+        return false;
+      }
+    }
+    p_grid.unset(_last);
+    return !p_grid.is_occupied(0, 0) && !p_grid.is_occupied(0, 1);
+  }
+};
+
 int main(int argc, char **argv) {
 
   test::alg::tester _tester(argc, argv);
@@ -119,4 +975,19 @@ int main(int argc, char **argv) {
   run_test(_tester, test_000);
   run_test(_tester, test_001);
   run_test(_tester, test_002);
+  run_test(_tester, test_003);
+  run_test(_tester, test_004);
+  run_test(_tester, test_005);
+  run_test(_tester, test_006);
+  run_test(_tester, test_007);
+  run_test(_tester, test_008);
+  run_test(_tester, test_009);
+  run_test(_tester, test_010);
+  run_test(_tester, test_011);
+  run_test(_tester, test_012);
+  run_test(_tester, test_013);
+  run_test(_tester, test_014);
+  run_test(_tester, test_015);
+  run_test(_tester, test_016);
+  run_test(_tester, test_017);
 }
@@ -0,0 +1,196 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_TYP_ALPHABET_H
+#define TENACITAS_LIB_CROSSWORDS_TYP_ALPHABET_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tenacitas::lib::crosswords::typ {
+
+/// \brief A Unicode code point
+using code_point = char32_t;
+
+/// \brief Dense code of a letter in an \p alphabet, from 0 to
+/// \p alphabet::max_size - 1
+using letter = char;
+
+/// \brief Letters of a word, each one coded by an \p alphabet
+using letters = std::string;
+
+/// \brief Code point used when the input is not valid UTF-8
+static constexpr code_point invalid_code_point{0xFFFD};
+
+/// \brief Decodes UTF-8 text into code points
+///
+/// \details Invalid or truncated sequences are decoded as
+/// \p invalid_code_point, one for each invalid byte
+std::u32string decode_utf8(const std::string &p_text) {
+  std::u32string _code_points;
+  const size_t _size{p_text.size()};
+  size_t _i{0};
+  while (_i < _size) {
+    const auto _byte{static_cast<uint8_t>(p_text[_i])};
+    size_t _length{0};
+    code_point _code_point{0};
+    if (_byte < 0x80) {
+      _length = 1;
+      _code_point = _byte;
+    } else if ((_byte & 0xE0) == 0xC0) {
+      _length = 2;
+      _code_point = _byte & 0x1F;
+    } else if ((_byte & 0xF0) == 0xE0) {
+      _length = 3;
+      _code_point = _byte & 0x0F;
+    } else if ((_byte & 0xF8) == 0xF0) {
+      _length = 4;
+      _code_point = _byte & 0x07;
+    }
+
+    bool _valid{(_length != 0) && (_i + _length <= _size)};
+    for (size_t _j = 1; _valid && (_j < _length); ++_j) {
+      const auto _next{static_cast<uint8_t>(p_text[_i + _j])};
+      if ((_next & 0xC0) != 0x80) {
+        _valid = false;
+      } else {
+        _code_point = (_code_point << 6) | (_next & 0x3F);
+      }
+    }
+
+    if (_valid) {
+      _code_points.push_back(_code_point);
+      _i += _length;
+    } else {
+      _code_points.push_back(invalid_code_point);
+      ++_i;
+    }
+  }
+  return _code_points;
+}
+
+/// \brief Encodes a code point into UTF-8 text
+std::string encode_utf8(code_point p_code_point) {
+  std::string _text;
+  if (p_code_point < 0x80) {
+    _text.push_back(static_cast<char>(p_code_point));
+  } else if (p_code_point < 0x800) {
+    _text.push_back(static_cast<char>(0xC0 | (p_code_point >> 6)));
+    _text.push_back(static_cast<char>(0x80 | (p_code_point & 0x3F)));
+  } else if (p_code_point < 0x10000) {
+    _text.push_back(static_cast<char>(0xE0 | (p_code_point >> 12)));
+    _text.push_back(static_cast<char>(0x80 | ((p_code_point >> 6) & 0x3F)));
+    _text.push_back(static_cast<char>(0x80 | (p_code_point & 0x3F)));
+  } else {
+    _text.push_back(static_cast<char>(0xF0 | (p_code_point >> 18)));
+    _text.push_back(static_cast<char>(0x80 | ((p_code_point >> 12) & 0x3F)));
+    _text.push_back(static_cast<char>(0x80 | ((p_code_point >> 6) & 0x3F)));
+    _text.push_back(static_cast<char>(0x80 | (p_code_point & 0x3F)));
+  }
+  return _text;
+}
+
+/// \brief Number of code points in UTF-8 text
+size_t count_utf8(const std::string &p_text) {
+  return static_cast<size_t>(
+      std::count_if(p_text.begin(), p_text.end(), [](char p_c) {
+        return (static_cast<uint8_t>(p_c) & 0xC0) != 0x80;
+      }));
+}
+
+/// \brief Maps the code points used by a set of words to dense codes
+///
+/// \details Words arrive as UTF-8, so accented letters, like the ones in
+/// Portuguese words, are more than one \p char. The \p alphabet decodes them,
+/// and gives each distinct code point a \p letter from 0 to \p max_size - 1,
+/// in the order they are first seen. Grids, and the tables indexed by
+/// letter, only have to deal with the letters really used.
+struct alphabet {
+  /// \brief Maximum number of letters, so a \p letter fits in 6 bits
+  static constexpr size_t max_size{64};
+
+  alphabet() = default;
+
+  /// \brief Builds an alphabet with all the code points of the words
+  ///
+  /// \throw std::runtime_error if there are more than \p max_size code points
+  template <typename t_iterator>
+  alphabet(t_iterator p_begin, t_iterator p_end) {
+    for (; p_begin != p_end; ++p_begin) {
+      add(*p_begin);
+    }
+  }
+
+  alphabet(const alphabet &) = default;
+  alphabet(alphabet &&) = default;
+  ~alphabet() = default;
+
+  alphabet &operator=(const alphabet &) = default;
+  alphabet &operator=(alphabet &&) = default;
+
+  /// \brief Adds all the code points of a word that are not yet in the
+  /// alphabet
+  ///
+  /// \throw std::runtime_error if there are more than \p max_size code points
+  void add(const std::string &p_word) {
+    for (code_point _code_point : decode_utf8(p_word)) {
+      if (m_letters.find(_code_point) != m_letters.end()) {
+        continue;
+      }
+      if (m_code_points.size() == max_size) {
+        throw std::runtime_error("more than " + std::to_string(max_size) +
+                                 " letters in the alphabet");
+      }
+      m_letters[_code_point] = static_cast<letter>(m_code_points.size());
+      m_code_points.push_back(_code_point);
+    }
+  }
+
+  /// \brief Number of letters in the alphabet
+  inline size_t size() const { return m_code_points.size(); }
+
+  /// \brief Codes a UTF-8 word
+  ///
+  /// \throw std::runtime_error if a code point is not in the alphabet
+  letters encode(const std::string &p_word) const {
+    letters _letters;
+    for (code_point _code_point : decode_utf8(p_word)) {
+      auto _ite{m_letters.find(_code_point)};
+      if (_ite == m_letters.end()) {
+        throw std::runtime_error("word '" + p_word +
+                                 "' has a letter not in the alphabet");
+      }
+      _letters.push_back(_ite->second);
+    }
+    return _letters;
+  }
+
+  /// \brief UTF-8 text of a letter
+  inline std::string decode(letter p_letter) const {
+    return encode_utf8(m_code_points[static_cast<uint8_t>(p_letter)]);
+  }
+
+  /// \brief UTF-8 text of a sequence of letters
+  template <typename t_letters>
+  std::string decode(const t_letters &p_letters) const {
+    std::string _word;
+    for (letter _letter : p_letters) {
+      _word += decode(_letter);
+    }
+    return _word;
+  }
+
+private:
+  std::map<code_point, letter> m_letters;
+  std::vector<code_point> m_code_points;
+};
+
+} // namespace tenacitas::lib::crosswords::typ
+
+#endif
@@ -7,31 +7,41 @@
 /// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <iomanip>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <optional>
 
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include <tenacitas.lib.container/typ/matrix.h>
+#include <tenacitas.lib.crosswords/typ/alphabet.h>
+#include <tenacitas.lib.crosswords/typ/simd.h>
 #include <tenacitas.lib.log/alg/logger.h>
 
 namespace tenacitas::lib::crosswords::typ {
 
-/// \brief Index in a grid
-using index = int16_t;
+/// \brief Index in a grid, wide enough for grids of thousands of rows and
+/// columns
+using index = int32_t;
 
-/// \brief Word to be positioned in a grid
+/// \brief Word to be positioned in a grid, in UTF-8
 using word = std::string;
 
-/// \brief Helper function to get the size of a word
-index get_size(const word &p_word) { return static_cast<index>(p_word.size()); }
+/// \brief Helper function to get the size of a word, in letters, not in
+/// \p char
+index get_size(const word &p_word) {
+  return static_cast<index>(count_utf8(p_word));
+}
 
 /// \brief Maximum length of a \p word
 static constexpr word::value_type max_char{
@@ -70,7 +80,7 @@ static const entry empty_entry{"", ""};
 /// \brief A set of \p entry
 struct entries {
 
-  using size = uint8_t;
+  using size = uint32_t;
   using collection = std::vector<entry>;
   using const_entry_ite = collection::const_iterator;
   using entry_ite = collection::iterator;
@@ -135,24 +145,670 @@ static constexpr index max_row{std::numeric_limits<index>::max()};
 static constexpr index max_col{std::numeric_limits<index>::max()};
 
 /// \brief Possible orientations of a \p word in a grid
-enum class orientation : char { vert = 'V', hori = 'H', undef = 'U' };
+///
+/// \details A crosswords uses only \p hori, going right, and \p vert, going
+/// down. A word search puzzle also uses \p diag, going down and right,
+/// \p anti_diag, going down and left, and the \p _back orientations, which
+/// go the opposite way of the others
+enum class orientation : char {
+  vert = 'V',
+  hori = 'H',
+  vert_back = 'v',
+  hori_back = 'h',
+  diag = 'D',
+  diag_back = 'd',
+  anti_diag = 'A',
+  anti_diag_back = 'a',
+  undef = 'U'
+};
 
 std::ostream &operator<<(std::ostream &p_out, orientation p_orientation) {
   p_out << static_cast<char>(p_orientation);
   return p_out;
 }
 
+/// \brief The orientations of the words of a crosswords
+static constexpr std::array<orientation, 2> crosswords_orientations{
+    orientation::hori, orientation::vert};
+
+/// \brief The orientations of the words of a word search puzzle
+static constexpr std::array<orientation, 8> all_orientations{
+    orientation::hori,      orientation::vert,
+    orientation::hori_back, orientation::vert_back,
+    orientation::diag,      orientation::diag_back,
+    orientation::anti_diag, orientation::anti_diag_back};
+
+/// \brief Rows from a letter of a word to the next, in \p p_orientation
+constexpr index row_step(orientation p_orientation) {
+  switch (p_orientation) {
+  case orientation::vert:
+  case orientation::diag:
+  case orientation::anti_diag:
+    return 1;
+  case orientation::vert_back:
+  case orientation::diag_back:
+  case orientation::anti_diag_back:
+    return -1;
+  default:
+    return 0;
+  }
+}
+
+/// \brief Columns from a letter of a word to the next, in \p p_orientation
+constexpr index col_step(orientation p_orientation) {
+  switch (p_orientation) {
+  case orientation::hori:
+  case orientation::diag:
+  case orientation::anti_diag_back:
+    return 1;
+  case orientation::hori_back:
+  case orientation::diag_back:
+  case orientation::anti_diag:
+    return -1;
+  default:
+    return 0;
+  }
+}
+
+/// \brief Spreads the bits of a 64 bits value, as the finalizer of splitmix64
+uint64_t mix(uint64_t p_value) {
+  p_value ^= p_value >> 30;
+  p_value *= 0xBF58476D1CE4E5B9ULL;
+  p_value ^= p_value >> 27;
+  p_value *= 0x94D049BB133111EBULL;
+  p_value ^= p_value >> 31;
+  return p_value;
+}
+
+/// \brief Zobrist key of a word positioned at a row, column and orientation
+///
+/// \details Instead of a table of random keys, one per word, row, column and
+/// orientation, the key is computed by mixing their bits, so grids of any
+/// size need no table
+///
+/// \param p_word identifies the word in all the grids, like the hash of its
+/// text
+uint64_t position_key(uint64_t p_word, index p_row, index p_col,
+                      orientation p_orientation) {
+  return mix(p_word ^ mix((static_cast<uint64_t>(p_row) << 32) ^
+                          (static_cast<uint64_t>(p_col) << 8) ^
+                          static_cast<uint64_t>(p_orientation)));
+}
+
 /// \brief Row and Column
 using coordinate = std::pair<index, index>;
 
 /// \brief Set of rows and columns
 using coordinates = std::vector<coordinate>;
 
+/// \brief Set of bits of a line of cells, one bit per cell
+using block = uint64_t;
+
+/// \brief Number of cells in a \p block
+static constexpr index block_size{64};
+
+/// \brief Number of \p block needed for a line of \p p_num_cells cells
+constexpr index num_blocks(index p_num_cells) {
+  return static_cast<index>((p_num_cells + block_size - 1) / block_size);
+}
+
+/// \brief A \p letter, and the bits of a word where the letter occurs
+using letter_mask = std::pair<letter, block>;
+
+/// \brief All the \p letter_mask of a word
+using letter_masks = std::vector<letter_mask>;
+
+/// \brief Number of words positioned in a cell, which can be as many as the
+/// words of a grid
+using use_count = uint32_t;
+
+/// \brief Dimensions of a grid defined at run time
+///
+/// \details The cells and the sets of bits of the grid are allocated in the
+/// heap, and every position is calculated with the number of rows and columns
+/// read from memory
+struct dynamic_dimensions {
+  using cells = std::vector<letter>;
+  using use_counts = std::vector<use_count>;
+  using row_blocks = std::vector<block>;
+  using col_blocks = std::vector<block>;
+
+  dynamic_dimensions() = default;
+
+  dynamic_dimensions(index p_num_rows, index p_num_cols)
+      : m_num_rows(p_num_rows), m_num_cols(p_num_cols) {}
+
+  dynamic_dimensions(const dynamic_dimensions &) = default;
+  dynamic_dimensions(dynamic_dimensions &&) = default;
+  ~dynamic_dimensions() = default;
+
+  dynamic_dimensions &operator=(const dynamic_dimensions &) = default;
+  dynamic_dimensions &operator=(dynamic_dimensions &&) = default;
+
+  inline index get_num_rows() const { return m_num_rows; }
+  inline index get_num_cols() const { return m_num_cols; }
+
+  /// \brief All the cells, followed by \p simd::padding cells, with
+  /// \p p_value, which is an empty cell by default
+  cells create_cells(letter p_value = max_char) const {
+    return cells(static_cast<size_t>(m_num_rows) * m_num_cols + simd::padding,
+                 p_value);
+  }
+
+  /// \brief Same as \p create_cells, for the cells kept column by column
+  inline cells create_transposed_cells(letter p_value = max_char) const {
+    return create_cells(p_value);
+  }
+
+  /// \brief The number of words positioned in each cell, row by row, zeroed
+  use_counts create_use_counts() const {
+    return use_counts(static_cast<size_t>(m_num_rows) * m_num_cols, 0);
+  }
+
+  /// \brief The blocks of all the rows, cleared
+  row_blocks create_row_blocks() const {
+    return row_blocks(static_cast<size_t>(m_num_rows) * num_blocks(m_num_cols),
+                      0);
+  }
+
+  /// \brief The blocks of all the columns, cleared
+  col_blocks create_col_blocks() const {
+    return col_blocks(static_cast<size_t>(m_num_cols) * num_blocks(m_num_rows),
+                      0);
+  }
+
+private:
+  index m_num_rows{0};
+  index m_num_cols{0};
+};
+
+/// \brief Dimensions of a grid defined at compile time
+///
+/// \details The cells and the sets of bits of the grid are \p std::array, so
+/// there is no heap allocation for them, and the number of rows and columns
+/// are constants, allowing the compiler to fold the position calculations and
+/// to unroll the scans of rows and columns
+///
+/// \tparam t_num_rows number of rows of the grid
+///
+/// \tparam t_num_cols number of columns of the grid
+template <index t_num_rows, index t_num_cols> struct fixed_dimensions {
+  static_assert((t_num_rows > 0) && (t_num_cols > 0),
+                "a grid must have at least one row and one column");
+
+  using cells = std::array<letter, static_cast<size_t>(t_num_rows) * t_num_cols +
+                                       simd::padding>;
+  using use_counts =
+      std::array<use_count, static_cast<size_t>(t_num_rows) * t_num_cols>;
+  using row_blocks =
+      std::array<block, static_cast<size_t>(t_num_rows) * num_blocks(t_num_cols)>;
+  using col_blocks =
+      std::array<block, static_cast<size_t>(t_num_cols) * num_blocks(t_num_rows)>;
+
+  fixed_dimensions() = default;
+
+  /// \brief Constructor that allows \p fixed_dimensions to be used where
+  /// \p dynamic_dimensions is
+  ///
+  /// \throw std::runtime_error if \p p_num_rows is not \p t_num_rows, or if
+  /// \p p_num_cols is not \p t_num_cols
+  fixed_dimensions(index p_num_rows, index p_num_cols) {
+    if ((p_num_rows != t_num_rows) || (p_num_cols != t_num_cols)) {
+      std::string _err("Grid of " + std::to_string(t_num_rows) + " rows and " +
+                       std::to_string(t_num_cols) +
+                       " columns can not be created with " +
+                       std::to_string(p_num_rows) + " rows and " +
+                       std::to_string(p_num_cols) + " columns");
+      TNCT_LOG_ERR(_err);
+      throw std::runtime_error(_err);
+    }
+  }
+
+  fixed_dimensions(const fixed_dimensions &) = default;
+  fixed_dimensions(fixed_dimensions &&) = default;
+  ~fixed_dimensions() = default;
+
+  fixed_dimensions &operator=(const fixed_dimensions &) = default;
+  fixed_dimensions &operator=(fixed_dimensions &&) = default;
+
+  static constexpr index get_num_rows() { return t_num_rows; }
+  static constexpr index get_num_cols() { return t_num_cols; }
+
+  /// \brief All the cells, followed by \p simd::padding cells, with
+  /// \p p_value, which is an empty cell by default
+  static cells create_cells(letter p_value = max_char) {
+    cells _cells;
+    _cells.fill(p_value);
+    return _cells;
+  }
+
+  /// \brief Same as \p create_cells, for the cells kept column by column
+  static inline cells create_transposed_cells(letter p_value = max_char) {
+    return create_cells(p_value);
+  }
+
+  /// \brief The number of words positioned in each cell, row by row, zeroed
+  static use_counts create_use_counts() {
+    use_counts _uses;
+    _uses.fill(0);
+    return _uses;
+  }
+
+  /// \brief The blocks of all the rows, cleared
+  static row_blocks create_row_blocks() {
+    row_blocks _blocks;
+    _blocks.fill(0);
+    return _blocks;
+  }
+
+  /// \brief The blocks of all the columns, cleared
+  static col_blocks create_col_blocks() {
+    col_blocks _blocks;
+    _blocks.fill(0);
+    return _blocks;
+  }
+};
+
+/// \brief Cells of a grid kept line by line, where a line is only allocated
+/// when one of its cells is changed
+///
+/// \details Reading a cell of a line not allocated reads a line with all the
+/// cells with the initial value, so the cells of a line are always
+/// contiguous, followed by \p simd::padding cells, and the memory is
+/// proportional to the number of lines used, not to the area of the grid
+///
+/// \tparam t_value type of the value of a cell, like \p letter
+template <typename t_value> struct basic_lazy_cells {
+  basic_lazy_cells() = default;
+
+  /// \param p_num_lines number of rows, or columns, of the grid
+  ///
+  /// \param p_line_size number of cells of a line
+  ///
+  /// \param p_value value of the cells not changed
+  basic_lazy_cells(size_t p_num_lines, size_t p_line_size, t_value p_value)
+      : m_line_size(p_line_size), m_value(p_value), m_lines(p_num_lines),
+        m_empty(p_line_size + simd::padding, p_value) {}
+
+  basic_lazy_cells(const basic_lazy_cells &) = default;
+  basic_lazy_cells(basic_lazy_cells &&) = default;
+  ~basic_lazy_cells() = default;
+
+  basic_lazy_cells &operator=(const basic_lazy_cells &) = default;
+  basic_lazy_cells &operator=(basic_lazy_cells &&) = default;
+
+  inline const t_value &operator[](size_t p_pos) const {
+    const std::vector<t_value> &_line{m_lines[p_pos / m_line_size]};
+    return _line.empty() ? m_empty[p_pos % m_line_size]
+                         : _line[p_pos % m_line_size];
+  }
+
+  /// \brief Allocates the line of the cell, if it is not allocated
+  t_value &operator[](size_t p_pos) {
+    std::vector<t_value> &_line{m_lines[p_pos / m_line_size]};
+    if (_line.empty()) {
+      _line.assign(m_line_size + simd::padding, m_value);
+    }
+    return _line[p_pos % m_line_size];
+  }
+
+  /// \brief Releases all the lines, so all the cells have the initial value
+  void release() {
+    for (std::vector<t_value> &_line : m_lines) {
+      std::vector<t_value>().swap(_line);
+    }
+  }
+
+  /// \brief Number of lines allocated
+  size_t get_num_allocated() const {
+    return static_cast<size_t>(std::count_if(
+        m_lines.begin(), m_lines.end(),
+        [](const std::vector<t_value> &p_line) { return !p_line.empty(); }));
+  }
+
+private:
+  size_t m_line_size{1};
+  t_value m_value{};
+  std::vector<std::vector<t_value>> m_lines;
+
+  /// \brief Line read for the lines not allocated
+  std::vector<t_value> m_empty;
+};
+
+using lazy_cells = basic_lazy_cells<letter>;
+
+/// \brief Dimensions of a grid defined at run time, for big grids where few
+/// cells are used, like 1000x1000 or more
+///
+/// \details The cells are \p lazy_cells, so only the rows and columns used
+/// by a word are allocated, while the sets of bits, one bit per cell, are
+/// allocated as in \p dynamic_dimensions. Each cell read or written costs a
+/// division more than with \p dynamic_dimensions.
+struct sparse_dimensions {
+  using cells = lazy_cells;
+  using use_counts = basic_lazy_cells<use_count>;
+  using row_blocks = std::vector<block>;
+  using col_blocks = std::vector<block>;
+
+  sparse_dimensions() = default;
+
+  sparse_dimensions(index p_num_rows, index p_num_cols)
+      : m_num_rows(p_num_rows), m_num_cols(p_num_cols) {}
+
+  sparse_dimensions(const sparse_dimensions &) = default;
+  sparse_dimensions(sparse_dimensions &&) = default;
+  ~sparse_dimensions() = default;
+
+  sparse_dimensions &operator=(const sparse_dimensions &) = default;
+  sparse_dimensions &operator=(sparse_dimensions &&) = default;
+
+  inline index get_num_rows() const { return m_num_rows; }
+  inline index get_num_cols() const { return m_num_cols; }
+
+  /// \brief All the cells, row by row, with \p p_value, which is an empty
+  /// cell by default
+  cells create_cells(letter p_value = max_char) const {
+    return cells(static_cast<size_t>(m_num_rows),
+                 static_cast<size_t>(m_num_cols), p_value);
+  }
+
+  /// \brief All the cells, column by column, with \p p_value
+  cells create_transposed_cells(letter p_value = max_char) const {
+    return cells(static_cast<size_t>(m_num_cols),
+                 static_cast<size_t>(m_num_rows), p_value);
+  }
+
+  /// \brief The number of words positioned in each cell, row by row, zeroed
+  use_counts create_use_counts() const {
+    return use_counts(static_cast<size_t>(m_num_rows),
+                      static_cast<size_t>(m_num_cols), 0);
+  }
+
+  /// \brief The blocks of all the rows, cleared
+  row_blocks create_row_blocks() const {
+    return row_blocks(static_cast<size_t>(m_num_rows) * num_blocks(m_num_cols),
+                      0);
+  }
+
+  /// \brief The blocks of all the columns, cleared
+  col_blocks create_col_blocks() const {
+    return col_blocks(static_cast<size_t>(m_num_cols) * num_blocks(m_num_rows),
+                      0);
+  }
+
+private:
+  index m_num_rows{0};
+  index m_num_cols{0};
+};
+
+/// \brief Occupancy of a grid kept as sets of bits
+///
+/// \details There is one set of bits per row and one per column, where a bit
+/// set means the cell is occupied. Optionally, for each \p letter of the
+/// \p alphabet of the grid, there is also one set of bits per row and one per
+/// column, where a bit set means the cell is occupied by that letter.
+/// This allows to check if a span of cells is free, or if a word can be placed
+/// on it, with a few AND operations per block of 64 cells, instead of reading
+/// cell by cell.
+///
+/// \tparam t_dimensions defines the dimensions of the grid, and the storage of
+/// the sets of bits, like \p dynamic_dimensions, \p sparse_dimensions or
+/// \p fixed_dimensions
+template <typename t_dimensions> struct basic_bitboard {
+  using block = typ::block;
+  using letter_mask = typ::letter_mask;
+  using letter_masks = typ::letter_masks;
+
+  static constexpr index block_size{typ::block_size};
+
+  basic_bitboard() = default;
+
+  /// \brief Constructor
+  ///
+  /// \param p_num_rows number of rows in the grid
+  ///
+  /// \param p_num_cols number of columns in the grid
+  ///
+  /// \param p_num_letters number of letters, from 0 to \p p_num_letters - 1,
+  /// for which there will be a set of bits per row and per column; if it is
+  /// 0, only the occupancy is kept
+  basic_bitboard(index p_num_rows, index p_num_cols, size_t p_num_letters = 0)
+      : basic_bitboard(t_dimensions(p_num_rows, p_num_cols), p_num_letters) {}
+
+  /// \brief Constructor
+  ///
+  /// \param p_dimensions dimensions of the grid
+  ///
+  /// \param p_num_letters number of letters, from 0 to \p p_num_letters - 1,
+  /// for which there will be a set of bits per row and per column; if it is
+  /// 0, only the occupancy is kept
+  basic_bitboard(const t_dimensions &p_dimensions, size_t p_num_letters)
+      : m_dimensions(p_dimensions), m_num_letters(p_num_letters),
+        m_rows(m_dimensions.create_row_blocks()),
+        m_cols(m_dimensions.create_col_blocks()),
+        m_letter_rows(m_num_letters * m_rows.size(), 0),
+        m_letter_cols(m_num_letters * m_cols.size(), 0) {}
+
+  basic_bitboard(const basic_bitboard &) = default;
+  basic_bitboard(basic_bitboard &&) = default;
+  ~basic_bitboard() = default;
+
+  basic_bitboard &operator=(const basic_bitboard &) = default;
+  basic_bitboard &operator=(basic_bitboard &&) = default;
+
+  /// \brief Informs if there are sets of bits per letter
+  inline bool has_letters() const { return m_num_letters != 0; }
+
+  /// \brief Marks a cell as occupied by a letter
+  void occupy(index p_row, index p_col, letter p_letter) {
+    const block _row_bit{block{1} << (p_col % block_size)};
+    const block _col_bit{block{1} << (p_row % block_size)};
+    const size_t _row_pos{row_pos(p_row, p_col / block_size)};
+    const size_t _col_pos{col_pos(p_col, p_row / block_size)};
+
+    m_rows[_row_pos] |= _row_bit;
+    m_cols[_col_pos] |= _col_bit;
+
+    const size_t _letter{static_cast<uint8_t>(p_letter)};
+    if (_letter < m_num_letters) {
+      m_letter_rows[_letter * m_rows.size() + _row_pos] |= _row_bit;
+      m_letter_cols[_letter * m_cols.size() + _col_pos] |= _col_bit;
+    }
+  }
+
+  /// \brief Marks a cell, occupied by a letter, as free
+  void release(index p_row, index p_col, letter p_letter) {
+    const block _row_bit{block{1} << (p_col % block_size)};
+    const block _col_bit{block{1} << (p_row % block_size)};
+    const size_t _row_pos{row_pos(p_row, p_col / block_size)};
+    const size_t _col_pos{col_pos(p_col, p_row / block_size)};
+
+    m_rows[_row_pos] &= ~_row_bit;
+    m_cols[_col_pos] &= ~_col_bit;
+
+    const size_t _letter{static_cast<uint8_t>(p_letter)};
+    if (_letter < m_num_letters) {
+      m_letter_rows[_letter * m_rows.size() + _row_pos] &= ~_row_bit;
+      m_letter_cols[_letter * m_cols.size() + _col_pos] &= ~_col_bit;
+    }
+  }
+
+  /// \brief Marks all cells as free
+  void reset() {
+    std::fill(m_rows.begin(), m_rows.end(), 0);
+    std::fill(m_cols.begin(), m_cols.end(), 0);
+    std::fill(m_letter_rows.begin(), m_letter_rows.end(), 0);
+    std::fill(m_letter_cols.begin(), m_letter_cols.end(), 0);
+  }
+
+  /// \brief Informs if \p p_size cells starting at \p p_row and \p p_col,
+  /// going right, are all free
+  inline bool is_free_horizontally(index p_row, index p_col,
+                                   index p_size) const {
+    return is_free(&m_rows[row_pos(p_row, 0)], p_col, p_size);
+  }
+
+  /// \brief Informs if \p p_size cells starting at \p p_row and \p p_col,
+  /// going down, are all free
+  inline bool is_free_vertically(index p_row, index p_col,
+                                 index p_size) const {
+    return is_free(&m_cols[col_pos(p_col, 0)], p_row, p_size);
+  }
+
+  /// \brief Builds the \p letter_masks of a word
+  ///
+  /// \return the masks, or an empty object if the word is longer than a
+  /// \p block, or if it has a letter without set of bits
+  letter_masks masks(const letters &p_letters) const {
+    letter_masks _masks;
+    if (p_letters.size() > static_cast<size_t>(block_size)) {
+      return {};
+    }
+    index _pos{0};
+    for (letter _letter : p_letters) {
+      if (static_cast<uint8_t>(_letter) >= m_num_letters) {
+        return {};
+      }
+      auto _ite{std::find_if(_masks.begin(), _masks.end(),
+                             [_letter](const letter_mask &p_mask) {
+                               return p_mask.first == _letter;
+                             })};
+      if (_ite == _masks.end()) {
+        _masks.push_back({_letter, block{1} << _pos});
+      } else {
+        _ite->second |= block{1} << _pos;
+      }
+      ++_pos;
+    }
+    return _masks;
+  }
+
+  /// \brief Informs if a word, with \p p_size letters and \p p_masks, can be
+  /// placed starting at \p p_row and \p p_col, going right, i.e., if every
+  /// cell it would occupy is free or has the same letter
+  ///
+  /// \pre has_letters() must be true, and \p p_masks must not be empty
+  inline bool fits_horizontally(index p_row, index p_col, index p_size,
+                                const letter_masks &p_masks) const {
+    return fits(m_rows, m_letter_rows, row_pos(p_row, 0), p_col, p_size,
+                p_masks);
+  }
+
+  /// \brief Informs if a word, with \p p_size letters and \p p_masks, can be
+  /// placed starting at \p p_row and \p p_col, going down, i.e., if every
+  /// cell it would occupy is free or has the same letter
+  ///
+  /// \pre has_letters() must be true, and \p p_masks must not be empty
+  inline bool fits_vertically(index p_row, index p_col, index p_size,
+                              const letter_masks &p_masks) const {
+    return fits(m_cols, m_letter_cols, col_pos(p_col, 0), p_row, p_size,
+                p_masks);
+  }
+
+private:
+  inline size_t row_pos(index p_row, index p_block) const {
+    return static_cast<size_t>(p_row) *
+               num_blocks(m_dimensions.get_num_cols()) +
+           p_block;
+  }
+
+  inline size_t col_pos(index p_col, index p_block) const {
+    return static_cast<size_t>(p_col) *
+               num_blocks(m_dimensions.get_num_rows()) +
+           p_block;
+  }
+
+  /// \brief Part of the bits \p p_bits, shifted to start at cell \p p_start,
+  /// that falls into block \p p_block
+  static inline block shifted(block p_bits, index p_start, index p_block) {
+    const index _first{static_cast<index>(p_start / block_size)};
+    const index _shift{static_cast<index>(p_start % block_size)};
+    if (p_block == _first) {
+      return p_bits << _shift;
+    }
+    if ((p_block == _first + 1) && (_shift != 0)) {
+      return p_bits >> (block_size - _shift);
+    }
+    return 0;
+  }
+
+  static inline block span(index p_size) {
+    return (p_size >= block_size) ? ~block{0} : ((block{1} << p_size) - 1);
+  }
+
+  static bool is_free(const block *p_line, index p_start, index p_size) {
+    index _cell{p_start};
+    const index _end{static_cast<index>(p_start + p_size)};
+    while (_cell < _end) {
+      const index _block{static_cast<index>(_cell / block_size)};
+      const index _shift{static_cast<index>(_cell % block_size)};
+      const index _count{
+          std::min<index>(static_cast<index>(block_size - _shift),
+                          static_cast<index>(_end - _cell))};
+      if (p_line[_block] & (span(_count) << _shift)) {
+        return false;
+      }
+      _cell += _count;
+    }
+    return true;
+  }
+
+  template <typename t_lines>
+  bool fits(const t_lines &p_lines, const std::vector<block> &p_letter_lines,
+            size_t p_line_pos,
+            index p_start, index p_size, const letter_masks &p_masks) const {
+    const index _first{static_cast<index>(p_start / block_size)};
+    const index _last{static_cast<index>((p_start + p_size - 1) / block_size)};
+    const block _span{span(p_size)};
+
+    for (index _block = _first; _block <= _last; ++_block) {
+      const block _occupied{p_lines[p_line_pos + _block] &
+                            shifted(_span, p_start, _block)};
+      if (!_occupied) {
+        continue;
+      }
+      block _matched{0};
+      for (const letter_mask &_mask : p_masks) {
+        _matched |=
+            p_letter_lines[static_cast<uint8_t>(_mask.first) * p_lines.size() +
+                           p_line_pos + _block] &
+            shifted(_mask.second, p_start, _block);
+      }
+      if (_occupied & ~_matched) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  t_dimensions m_dimensions;
+  size_t m_num_letters{0};
+  typename t_dimensions::row_blocks m_rows;
+  typename t_dimensions::col_blocks m_cols;
+  std::vector<block> m_letter_rows;
+  std::vector<block> m_letter_cols;
+};
+
+/// \brief Occupancy of a grid with dimensions defined at run time
+using bitboard = basic_bitboard<dynamic_dimensions>;
+
 /// \brief An \p entry with a \p orientation and \p coordinate defined
 struct layout {
   layout() = default;
 
-  layout(entries::const_entry_ite p_entry) : m_entry(p_entry) {}
+  layout(entries::const_entry_ite p_entry)
+      : m_entry(p_entry), m_key(std::hash<word>{}(p_entry->get_word())) {}
+
+  /// \brief Constructor
+  ///
+  /// \param p_entry the \p entry of the \p layout
+  ///
+  /// \param p_letters the word of \p p_entry coded by an \p alphabet
+  layout(entries::const_entry_ite p_entry, letters &&p_letters)
+      : m_entry(p_entry), m_key(std::hash<word>{}(p_entry->get_word())),
+        m_letters(std::move(p_letters)),
+        m_padded_letters(m_letters + letters(simd::padding, '\0')) {}
 
   layout(const layout &) = default;
   layout(layout &&) = default;
@@ -164,18 +820,34 @@ struct layout {
 
   friend std::ostream &operator<<(std::ostream &p_out, const layout &p_layout) {
     p_out << "('" << p_layout.m_entry->get_word() << "',"
-          << static_cast<uint16_t>(p_layout.m_row) << ','
-          << static_cast<uint16_t>(p_layout.m_col) << ','
+          << p_layout.m_row << ',' << p_layout.m_col << ','
           << p_layout.m_orientation << ')';
 
     return p_out;
   }
 
   inline const word &get_word() const { return m_entry->get_word(); }
+
+  /// \brief Identifies the word in all the permutations, as the hash of its
+  /// text
+  inline uint64_t get_key() const { return m_key; }
+
+  /// \brief The word coded by the \p alphabet of the grid
+  inline const letters &get_letters() const { return m_letters; }
+
+  /// \brief Number of letters of the word
+  inline index get_size() const { return static_cast<index>(m_letters.size()); }
+
+  /// \brief The coded word followed by \p simd::padding bytes, so it can be
+  /// compared with \p simd::fits_padded
+  inline const letters &get_padded_letters() const { return m_padded_letters; }
   inline index get_row() const { return m_row; }
   inline index get_col() const { return m_col; }
   inline orientation get_orientation() const { return m_orientation; }
-  inline void set_entry(entries::const_entry_ite p_entry) { m_entry = p_entry; }
+  inline void set_entry(entries::const_entry_ite p_entry) {
+    m_entry = p_entry;
+    m_key = std::hash<word>{}(p_entry->get_word());
+  }
   inline void set_row(index p_x) { m_row = p_x; }
   inline void set_col(index p_y) { m_col = p_y; }
   inline void set_orientation(orientation p_orientation) {
@@ -184,6 +856,12 @@ struct layout {
   inline bool is_positioned() const {
     return m_orientation != orientation::undef;
   }
+  inline const letter_masks &get_letter_masks() const {
+    return m_letter_masks;
+  }
+  inline void set_letter_masks(letter_masks &&p_letter_masks) {
+    m_letter_masks = std::move(p_letter_masks);
+  }
 
   void reset() {
     m_row = max_row;
@@ -193,21 +871,30 @@ struct layout {
 
 private:
   entries::const_entry_ite m_entry;
+  uint64_t m_key{0};
   index m_row{max_row};
   index m_col{max_col};
   orientation m_orientation{orientation::undef};
+  letter_masks m_letter_masks;
+  letters m_letters;
+  letters m_padded_letters;
 };
 
 /// \brief Defines which coordinates are occupied
 using occupied = lib::container::typ::matrix<index, word::value_type>;
 
 /// \brief Contains all the \p layout
-struct grid {
+///
+/// \tparam t_dimensions defines the dimensions of the grid, and the storage of
+/// its cells, like \p dynamic_dimensions, \p sparse_dimensions or
+/// \p fixed_dimensions
+template <typename t_dimensions> struct basic_grid {
+  using dimensions = t_dimensions;
   using layouts = std::vector<layout>;
   using const_layout_ite = layouts::const_iterator;
   using layout_ite = layouts::iterator;
 
-  grid() = default;
+  basic_grid() = default;
 
   /// \brief Constructor
   ///
@@ -219,32 +906,69 @@ struct grid {
   /// \param p_num_cols number of columns in the grid
   ///
   /// \param p_permutation_number number of permutation of a \p entries used
-  grid(const permutation &p_permutation, index p_num_rows, index p_num_cols,
-       uint64_t p_permutation_number = 0)
-      : m_longest(longest_word(p_permutation)), m_num_rows(p_num_rows),
-        m_num_cols(p_num_cols), m_permutation_number(p_permutation_number),
-        m_occupied(p_num_rows, p_num_cols, max_char) {
+  ///
+  /// \param p_letter_boards if \p true, a \p bitboard per letter is kept, so
+  /// checking if a word fits in a span that is not free does not require
+  /// reading the cells
+  basic_grid(const permutation &p_permutation, index p_num_rows,
+             index p_num_cols, uint64_t p_permutation_number = 0,
+             bool p_letter_boards = false)
+      : basic_grid(p_permutation, create_alphabet(p_permutation), p_num_rows,
+                   p_num_cols, p_permutation_number, p_letter_boards) {}
+
+  /// \brief Constructor
+  ///
+  /// \param p_permutation is a permutation of the \p entries to be used when
+  /// trying to assemble the grid
+  ///
+  /// \param p_alphabet codes all the letters of the words in \p p_permutation,
+  /// and can be shared among grids of permutations of the same \p entries
+  ///
+  /// \param p_num_rows number of rows in the grid
+  ///
+  /// \param p_num_cols number of columns in the grid
+  ///
+  /// \param p_permutation_number number of permutation of a \p entries used
+  ///
+  /// \param p_letter_boards if \p true, a \p bitboard per letter is kept, so
+  /// checking if a word fits in a span that is not free does not require
+  /// reading the cells
+  basic_grid(const permutation &p_permutation,
+             std::shared_ptr<const alphabet> p_alphabet, index p_num_rows,
+             index p_num_cols, uint64_t p_permutation_number = 0,
+             bool p_letter_boards = false)
+      : m_longest(longest_word(p_permutation)),
+        m_dimensions(p_num_rows, p_num_cols),
+        m_permutation_number(p_permutation_number), m_alphabet(p_alphabet),
+        m_cells(m_dimensions.create_cells()),
+        m_transposed(m_dimensions.create_transposed_cells()),
+        m_uses(m_dimensions.create_use_counts()),
+        m_bitboard(m_dimensions, p_letter_boards ? m_alphabet->size() : 0) {
 
     // checks if all the words fit in the grid
-    if ((m_longest > p_num_rows) && (m_longest > p_num_cols)) {
+    if ((m_longest > get_num_rows()) && (m_longest > get_num_cols())) {
       std::string _err("Longest word has " + std::to_string(m_longest) +
                        " chars, and is longer than " +
-                       std::to_string(p_num_rows) + " rows and " +
-                       std::to_string(p_num_cols) + " columns");
+                       std::to_string(get_num_rows()) + " rows and " +
+                       std::to_string(get_num_cols()) + " columns");
       TNCT_LOG_ERR(_err);
       throw std::runtime_error(_err);
     }
 
     // fills the collection of \p layout objects
     for (entries::const_entry_ite _entry : p_permutation) {
-      m_layouts.push_back(_entry);
+      m_layouts.push_back({_entry, m_alphabet->encode(_entry->get_word())});
+      if (m_bitboard.has_letters()) {
+        m_layouts.back().set_letter_masks(
+            m_bitboard.masks(m_layouts.back().get_letters()));
+      }
     }
 
     // row header format used when printing the grid to console
     {
       std::stringstream _stream;
       _stream << ' ';
-      for (index _col = 0; _col < m_occupied.get_num_cols(); ++_col) {
+      for (index _col = 0; _col < get_num_cols(); ++_col) {
         _stream << "+-";
       }
       _stream << "+\n";
@@ -255,7 +979,7 @@ struct grid {
     {
       std::stringstream _stream;
       _stream << ' ';
-      for (index _col = 0; _col < m_occupied.get_num_cols(); ++_col) {
+      for (index _col = 0; _col < get_num_cols(); ++_col) {
         _stream << ' ' << std::hex << std::uppercase << _col;
       }
       _stream << '\n';
@@ -291,22 +1015,23 @@ struct grid {
   /// A| | | | |e| |s| | | |r|
   /// +-+-+-+-+-+-+-+-+-+-+-+
   ///
-  friend std::ostream &operator<<(std::ostream &p_out, const grid &p_grid) {
+  friend std::ostream &operator<<(std::ostream &p_out,
+                                  const basic_grid &p_grid) {
     p_out << '\n';
 
-    const occupied &_occupied = p_grid.m_occupied;
-
-    index _row_size = _occupied.get_num_rows();
-    index _col_size = _occupied.get_num_cols();
+    index _row_size = p_grid.get_num_rows();
 
     p_out << p_grid.m_header << p_grid.m_horizontal_line;
 
     for (index _row = 0; _row < _row_size; ++_row) {
       p_out << std::hex << std::uppercase << _row << "|";
-      for (index _col = 0; _col < _col_size; ++_col) {
-        auto _c{_occupied(_row, _col)};
-        p_out << (_c == std::numeric_limits<word::value_type>::max() ? ' ' : _c)
-              << '|';
+      for (letter _letter : p_grid.get_row(_row)) {
+        if (_letter == max_char) {
+          p_out << ' ';
+        } else {
+          p_out << p_grid.m_alphabet->decode(_letter);
+        }
+        p_out << '|';
       }
       p_out << '\n' << p_grid.m_horizontal_line;
     }
@@ -317,8 +1042,59 @@ struct grid {
     return m_permutation_number;
   }
 
-  inline index get_num_rows() const { return m_num_rows; }
-  inline index get_num_cols() const { return m_num_cols; }
+  inline index get_num_rows() const { return m_dimensions.get_num_rows(); }
+  inline index get_num_cols() const { return m_dimensions.get_num_cols(); }
+
+  inline const t_dimensions &get_dimensions() const { return m_dimensions; }
+
+  /// \brief Codes the letters of the words in the grid
+  inline const alphabet &get_alphabet() const { return *m_alphabet; }
+
+  /// \brief Contiguous cells of a row, where an empty cell is \p max_char,
+  /// and the others have a \p letter
+  inline std::string_view get_row(index p_row) const {
+    return {&m_cells[cell_pos(p_row, 0)], static_cast<size_t>(get_num_cols())};
+  }
+
+  /// \brief Contiguous cells of a column, where an empty cell is \p max_char,
+  /// and the others have a \p letter
+  inline std::string_view get_col(index p_col) const {
+    return {&m_transposed[transposed_pos(0, p_col)],
+            static_cast<size_t>(get_num_rows())};
+  }
+
+  /// \brief Cells occupied by a positioned \p layout, read contiguously for
+  /// \p orientation::hori and \p orientation::vert
+  ///
+  /// \return an empty view for the other orientations, which are read with
+  /// \p read_letters
+  std::string_view read(const_layout_ite p_layout) const {
+    const size_t _size{p_layout->get_letters().size()};
+    if (p_layout->get_orientation() == orientation::vert) {
+      return get_col(p_layout->get_col()).substr(p_layout->get_row(), _size);
+    }
+    if (p_layout->get_orientation() == orientation::hori) {
+      return get_row(p_layout->get_row()).substr(p_layout->get_col(), _size);
+    }
+    return {};
+  }
+
+  /// \brief Cells occupied by a positioned \p layout, in the order of its
+  /// letters, for any orientation
+  letters read_letters(const_layout_ite p_layout) const {
+    if (!p_layout->is_positioned()) {
+      return {};
+    }
+    const index _row_step{row_step(p_layout->get_orientation())};
+    const index _col_step{col_step(p_layout->get_orientation())};
+    letters _letters(p_layout->get_letters().size(), max_char);
+    for (index _i = 0; _i < p_layout->get_size(); ++_i) {
+      _letters[static_cast<size_t>(_i)] =
+          m_cells[cell_pos(p_layout->get_row() + _i * _row_step,
+                           p_layout->get_col() + _i * _col_step)];
+    }
+    return _letters;
+  }
 
   inline layout_ite begin() { return m_layouts.begin(); }
   inline layout_ite end() { return m_layouts.end(); }
@@ -329,12 +1105,45 @@ struct grid {
 
   void set(layouts::iterator p_ite, index p_row, index p_col,
            orientation p_orientation) {
+    if (p_ite->is_positioned()) {
+      m_hash ^= key(p_ite);
+    }
     p_ite->set_row(p_row);
     p_ite->set_col(p_col);
     p_ite->set_orientation(p_orientation);
+    m_hash ^= key(p_ite);
     occupy(p_ite);
   }
 
+  /// \brief Removes a positioned word from the grid, freeing the cells that
+  /// are not used by other words
+  void unset(layouts::iterator p_ite) {
+    if (!p_ite->is_positioned()) {
+      return;
+    }
+    const index _row_step{row_step(p_ite->get_orientation())};
+    const index _col_step{col_step(p_ite->get_orientation())};
+    index _count = 0;
+    for (letter _c : p_ite->get_letters()) {
+      const index _row{p_ite->get_row() + _count * _row_step};
+      const index _col{p_ite->get_col() + _count * _col_step};
+      ++_count;
+      const size_t _pos{cell_pos(_row, _col)};
+      if (--m_uses[_pos] == 0) {
+        m_cells[_pos] = max_char;
+        m_transposed[transposed_pos(_row, _col)] = max_char;
+        m_bitboard.release(_row, _col, _c);
+      }
+    }
+    m_hash ^= key(p_ite);
+    p_ite->reset();
+  }
+
+  /// \brief Zobrist hash of the words positioned, i.e., the exclusive or of
+  /// the \p position_key of each one, so grids with the same words at the
+  /// same places have the same hash, whatever the order they were positioned
+  inline uint64_t get_hash() const { return m_hash; }
+
   bool organized() const {
     for (const layout &_layout : m_layouts) {
       if (_layout.get_orientation() == orientation::undef) {
@@ -348,11 +1157,104 @@ struct grid {
     for (layout &_layout : m_layouts) {
       _layout.reset();
     }
-    m_occupied.reset();
+    clear(m_cells, max_char);
+    clear(m_transposed, max_char);
+    clear(m_uses, use_count{0});
+    m_bitboard.reset();
+    m_hash = 0;
   }
 
-  inline std::optional<word::value_type> is_occupied(index p_row, index p_col) {
-    word::value_type _c = m_occupied(p_row, p_col);
+  /// \brief Informs if the word of \p p_layout can be placed starting at
+  /// \p p_row and \p p_col, going right, i.e., if every cell it would occupy
+  /// is free or has the same letter
+  bool fits_horizontally(index p_row, index p_col,
+                         const_layout_ite p_layout) const {
+    const index _size{p_layout->get_size()};
+    if (m_bitboard.is_free_horizontally(p_row, p_col, _size)) {
+      return true;
+    }
+    if (!p_layout->get_letter_masks().empty()) {
+      return m_bitboard.fits_horizontally(p_row, p_col, _size,
+                                          p_layout->get_letter_masks());
+    }
+    return simd::fits_padded(&m_cells[cell_pos(p_row, p_col)],
+                             p_layout->get_padded_letters().data(),
+                             static_cast<size_t>(_size), max_char);
+  }
+
+  /// \brief Informs if the word of \p p_layout can be placed starting at
+  /// \p p_row and \p p_col, going down, i.e., if every cell it would occupy
+  /// is free or has the same letter
+  bool fits_vertically(index p_row, index p_col,
+                       const_layout_ite p_layout) const {
+    const index _size{p_layout->get_size()};
+    if (m_bitboard.is_free_vertically(p_row, p_col, _size)) {
+      return true;
+    }
+    if (!p_layout->get_letter_masks().empty()) {
+      return m_bitboard.fits_vertically(p_row, p_col, _size,
+                                        p_layout->get_letter_masks());
+    }
+    return simd::fits_padded(&m_transposed[transposed_pos(p_row, p_col)],
+                             p_layout->get_padded_letters().data(),
+                             static_cast<size_t>(_size), max_char);
+  }
+
+  /// \brief Informs if a word of \p p_size letters, starting at \p p_row and
+  /// \p p_col, in \p p_orientation, has all its letters inside the grid
+  bool is_inside(index p_row, index p_col, orientation p_orientation,
+                 index p_size) const {
+    const index _last_row{p_row + (p_size - 1) * row_step(p_orientation)};
+    const index _last_col{p_col + (p_size - 1) * col_step(p_orientation)};
+    return (p_orientation != orientation::undef) && (p_size > 0) &&
+           (std::min(p_row, _last_row) >= 0) &&
+           (std::max(p_row, _last_row) < get_num_rows()) &&
+           (std::min(p_col, _last_col) >= 0) &&
+           (std::max(p_col, _last_col) < get_num_cols());
+  }
+
+  /// \brief Informs if the word of \p p_layout can be placed starting at
+  /// \p p_row and \p p_col, in \p p_orientation, i.e., if every cell it
+  /// would occupy is free or has the same letter
+  ///
+  /// \details \p orientation::hori and \p orientation::vert are checked with
+  /// \p fits_horizontally and \p fits_vertically. For the other ones, the
+  /// cells are not contiguous in the order of the letters, so they are
+  /// gathered to a buffer, which is compared to the word with the same
+  /// \p simd::fits_padded
+  ///
+  /// \pre the word is inside the grid, as checked by \p is_inside
+  bool fits(index p_row, index p_col, orientation p_orientation,
+            const_layout_ite p_layout) const {
+    if (p_orientation == orientation::hori) {
+      return fits_horizontally(p_row, p_col, p_layout);
+    }
+    if (p_orientation == orientation::vert) {
+      return fits_vertically(p_row, p_col, p_layout);
+    }
+
+    const index _size{p_layout->get_size()};
+    const index _row_step{row_step(p_orientation)};
+    const index _col_step{col_step(p_orientation)};
+
+    std::array<letter, max_gathered + simd::padding> _local{};
+    letters _long;
+    letter *_cells{_local.data()};
+    if (_size > index{max_gathered}) {
+      _long.assign(static_cast<size_t>(_size) + simd::padding, max_char);
+      _cells = _long.data();
+    }
+    for (index _i = 0; _i < _size; ++_i) {
+      _cells[_i] =
+          m_cells[cell_pos(p_row + _i * _row_step, p_col + _i * _col_step)];
+    }
+    return simd::fits_padded(_cells, p_layout->get_padded_letters().data(),
+                             static_cast<size_t>(_size), max_char);
+  }
+
+  /// \brief The \p letter in a cell, if it is occupied
+  inline std::optional<letter> is_occupied(index p_row, index p_col) const {
+    letter _c = m_cells[cell_pos(p_row, p_col)];
     if (_c == max_char) {
       return {};
     }
@@ -362,17 +1264,66 @@ struct grid {
   inline index longest_word() const { return m_longest; }
 
 private:
+  /// \brief Maximum number of letters gathered in \p fits without
+  /// allocating memory
+  static constexpr size_t max_gathered{64};
+
+  static inline uint64_t key(const_layout_ite p_layout) {
+    return position_key(p_layout->get_key(), p_layout->get_row(),
+                        p_layout->get_col(), p_layout->get_orientation());
+  }
+
   void occupy(const_layout_ite p_layout) {
+    const index _row_step{row_step(p_layout->get_orientation())};
+    const index _col_step{col_step(p_layout->get_orientation())};
     index _count = 0;
-    if (p_layout->get_orientation() == orientation::vert) {
-      for (word::value_type _c : p_layout->get_word()) {
-        m_occupied(p_layout->get_row() + _count++, p_layout->get_col()) = _c;
-      }
-    } else {
-      for (word::value_type _c : p_layout->get_word()) {
-        m_occupied(p_layout->get_row(), p_layout->get_col() + _count++) = _c;
-      }
+    for (letter _c : p_layout->get_letters()) {
+      const index _row{p_layout->get_row() + _count * _row_step};
+      const index _col{p_layout->get_col() + _count * _col_step};
+      ++_count;
+      const size_t _pos{cell_pos(_row, _col)};
+      m_cells[_pos] = _c;
+      ++m_uses[_pos];
+      m_transposed[transposed_pos(_row, _col)] = _c;
+      m_bitboard.occupy(_row, _col, _c);
+    }
+  }
+
+  /// \brief Sets all the cells to \p p_value
+  template <typename t_cells, typename t_value>
+  static inline void clear(t_cells &p_cells, t_value p_value) {
+    std::fill(p_cells.begin(), p_cells.end(), p_value);
+  }
+
+  /// \brief Releases all the lines, as \p p_value is always the initial value
+  /// of the cells
+  template <typename t_value, typename t_initial>
+  static inline void clear(basic_lazy_cells<t_value> &p_cells,
+                           t_initial /*p_value*/) {
+    p_cells.release();
+  }
+
+  /// \brief Position of a cell in \p m_cells, where cells of a row are
+  /// contiguous
+  inline size_t cell_pos(index p_row, index p_col) const {
+    return static_cast<size_t>(p_row) * get_num_cols() + p_col;
+  }
+
+  /// \brief Position of a cell in \p m_transposed, where cells of a column
+  /// are contiguous
+  inline size_t transposed_pos(index p_row, index p_col) const {
+    return static_cast<size_t>(p_col) * get_num_rows() + p_row;
+  }
+
+  /// \brief An \p alphabet with all the letters used in the words of a
+  /// permutation
+  static std::shared_ptr<const alphabet>
+  create_alphabet(const permutation &p_permutation) {
+    auto _alphabet{std::make_shared<alphabet>()};
+    for (entries::const_entry_ite _entry : p_permutation) {
+      _alphabet->add(_entry->get_word());
     }
+    return _alphabet;
   }
 
   index longest_word(const permutation &p_permutation) {
@@ -391,17 +1342,44 @@ private:
 
 private:
   index m_longest{0};
-  index m_num_rows{0};
-  index m_num_cols{0};
+  t_dimensions m_dimensions;
   uint64_t m_permutation_number;
 
-  occupied m_occupied;
+  std::shared_ptr<const alphabet> m_alphabet;
+
+  /// \brief Letters in the cells, row by row
+  typename t_dimensions::cells m_cells;
+
+  /// \brief Letters in the cells, column by column, so a vertical span is
+  /// contiguous as a horizontal span is in \p m_cells
+  typename t_dimensions::cells m_transposed;
+
+  /// \brief Number of positioned words using each cell, row by row, so
+  /// \p unset only frees the cells no other word uses
+  typename t_dimensions::use_counts m_uses;
+
+  basic_bitboard<t_dimensions> m_bitboard;
   layouts m_layouts;
 
+  /// \brief Zobrist hash of the words positioned
+  uint64_t m_hash{0};
+
   std::string m_header;
   std::string m_horizontal_line;
 };
 
+/// \brief A grid with dimensions defined at run time
+using grid = basic_grid<dynamic_dimensions>;
+
+/// \brief A grid with dimensions defined at run time, where only the rows and
+/// columns used are allocated, for grids like 1000x1000 or more
+using sparse_grid = basic_grid<sparse_dimensions>;
+
+/// \brief A grid with dimensions defined at compile time, like the usual
+/// 11x11, 13x13 and 15x15
+template <index t_num_rows, index t_num_cols>
+using fixed_grid = basic_grid<fixed_dimensions<t_num_rows, t_num_cols>>;
+
 } // namespace tenacitas::lib::crosswords::typ
 
 #endif // CROSSWORDS_H
@@ -0,0 +1,187 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_TYP_NOGOOD_STORE_H
+#define TENACITAS_LIB_CROSSWORDS_TYP_NOGOOD_STORE_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+#include <tenacitas.lib.crosswords/typ/grid.h>
+
+namespace tenacitas::lib::crosswords::typ {
+
+/// \brief Sets of word positions from which no organization is possible,
+/// shared by the organizers of all the threads
+///
+/// \details A set of positions is identified by a 64 bits key, the sum of the
+/// keys of its positions, so the order in which the words were positioned
+/// does not matter. The keys are kept in a table with a fixed number of
+/// slots, allocated once, where a key can be in one of \p probe_size slots
+/// after the one its hash points to. Keys are written and read with atomic
+/// operations, without locks, and when all those slots are taken the key is
+/// not kept, so the table never grows.
+///
+/// A set kept with \p insert_set is found by \p contains_subset in any set
+/// that has all its positions, as the key of each prefix of the set, in
+/// increasing order of the keys of its positions, is also kept.
+///
+/// Two different sets can have the same key, so a search that trusts this
+/// table can, very rarely, skip a set of positions that could be organized.
+struct nogood_store {
+  using key = uint64_t;
+
+  /// \brief Default number of slots, 8MB of keys
+  static constexpr size_t default_capacity{size_t{1} << 20};
+
+  /// \brief Number of slots where a key can be kept
+  static constexpr size_t probe_size{8};
+
+  /// \brief Constructor
+  ///
+  /// \param p_capacity number of keys that can be kept, rounded up to a power
+  /// of 2
+  nogood_store(size_t p_capacity = default_capacity) {
+    size_t _capacity{probe_size};
+    while (_capacity < p_capacity) {
+      _capacity <<= 1;
+    }
+    m_mask = _capacity - 1;
+    m_slots = std::make_unique<std::atomic<key>[]>(_capacity);
+    for (size_t _i = 0; _i < _capacity; ++_i) {
+      m_slots[_i].store(empty, std::memory_order_relaxed);
+    }
+  }
+
+  nogood_store(const nogood_store &) = delete;
+  nogood_store(nogood_store &&) = delete;
+  ~nogood_store() = default;
+
+  nogood_store &operator=(const nogood_store &) = delete;
+  nogood_store &operator=(nogood_store &&) = delete;
+
+  /// \brief Key of a word positioned at a row, column and orientation
+  ///
+  /// \param p_word identifies the word in all the grids, like the hash of the
+  /// word
+  static inline key position_key(uint64_t p_word, index p_row, index p_col,
+                                 orientation p_orientation) {
+    return typ::position_key(p_word, p_row, p_col, p_orientation);
+  }
+
+  /// \brief Keeps the key of a set of positions
+  ///
+  /// \return \p false if the key could not be kept because the table is full
+  /// around its slot
+  bool insert(key p_key) {
+    p_key = valid(p_key);
+    const size_t _first{static_cast<size_t>(mix(p_key))};
+    for (size_t _i = 0; _i < probe_size; ++_i) {
+      std::atomic<key> &_slot{m_slots[(_first + _i) & m_mask]};
+      key _current{_slot.load(std::memory_order_acquire)};
+      if (_current == p_key) {
+        return true;
+      }
+      if (_current == empty) {
+        if (_slot.compare_exchange_strong(_current, p_key,
+                                          std::memory_order_acq_rel)) {
+          m_size.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        // another thread took the slot, maybe with the same key
+        if (_current == p_key) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /// \brief Informs if the key of a set of positions was kept
+  bool contains(key p_key) const {
+    p_key = valid(p_key);
+    const size_t _first{static_cast<size_t>(mix(p_key))};
+    for (size_t _i = 0; _i < probe_size; ++_i) {
+      const key _current{
+          m_slots[(_first + _i) & m_mask].load(std::memory_order_acquire)};
+      if (_current == p_key) {
+        return true;
+      }
+      if (_current == empty) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  /// \brief Keeps a set of positions, so that \p contains_subset finds it in
+  /// any set that has all its positions
+  ///
+  /// \param p_base key added to the key of the set, like the key of the
+  /// dimensions of the grid
+  ///
+  /// \param p_begin, p_end keys of the positions, in increasing order
+  template <typename t_ite>
+  void insert_set(key p_base, t_ite p_begin, t_ite p_end) {
+    key _sum{p_base};
+    for (t_ite _ite = p_begin; _ite != p_end; ++_ite) {
+      _sum += *_ite;
+      insert(std::next(_ite) == p_end ? _sum : prefix(_sum));
+    }
+  }
+
+  /// \brief Informs if a set kept by \p insert_set has only positions of a
+  /// set
+  ///
+  /// \details The subsets are walked in increasing order of the keys of their
+  /// positions, going deeper only from prefixes of sets kept
+  ///
+  /// \param p_base key added to the key of the set when it was kept
+  ///
+  /// \param p_begin, p_end keys of the positions of the set, in increasing
+  /// order
+  template <typename t_ite>
+  bool contains_subset(key p_base, t_ite p_begin, t_ite p_end) const {
+    for (t_ite _ite = p_begin; _ite != p_end; ++_ite) {
+      const key _sum{p_base + *_ite};
+      if (contains(_sum)) {
+        return true;
+      }
+      if (contains(prefix(_sum)) &&
+          contains_subset(_sum, std::next(_ite), p_end)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// \brief Number of keys kept, approximately while other threads insert
+  inline size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+  /// \brief Number of slots
+  inline size_t capacity() const { return m_mask + 1; }
+
+private:
+  static constexpr key empty{0};
+
+  static inline key valid(key p_key) { return p_key == empty ? 1 : p_key; }
+
+  /// \brief Key of a prefix of a set whose sum of keys is \p p_sum, different
+  /// from the key of a set with the same sum
+  static inline key prefix(key p_sum) {
+    return mix(p_sum ^ 0x9E3779B97F4A7C15ULL);
+  }
+
+private:
+  size_t m_mask{0};
+  std::unique_ptr<std::atomic<key>[]> m_slots;
+  std::atomic<size_t> m_size{0};
+};
+
+} // namespace tenacitas::lib::crosswords::typ
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_TYP_SIMD_H
+#define TENACITAS_LIB_CROSSWORDS_TYP_SIMD_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace tenacitas::lib::crosswords::typ::simd {
+
+/// \brief Number of bytes that must be readable after the last cell of a span
+/// and after the last letter of a word, when calling \p fits_padded
+static constexpr size_t padding{32};
+
+/// \brief Informs if a word fits in a span of cells, i.e., if each cell is
+/// empty or has the same letter of the word
+///
+/// \details The cells are compared 32 at a time when AVX2 is available, 16 at
+/// a time with SSE2, and one by one otherwise. The last cells, when less than
+/// a vector, are copied to a local buffer and compared in one masked compare,
+/// so no byte beyond the span is ever read.
+///
+/// \param p_cells first cell of the span, where the next cells are contiguous
+///
+/// \param p_word first letter of the word
+///
+/// \param p_size number of letters in the word
+///
+/// \param p_empty value of an empty cell
+inline bool fits(const char *p_cells, const char *p_word, size_t p_size,
+                 char p_empty) {
+  size_t _i{0};
+
+#if defined(__AVX2__)
+  {
+    const __m256i _empty{_mm256_set1_epi8(p_empty)};
+    for (; _i + 32 <= p_size; _i += 32) {
+      const __m256i _cells{
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_cells + _i))};
+      const __m256i _word{
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_word + _i))};
+      const __m256i _ok{_mm256_or_si256(_mm256_cmpeq_epi8(_cells, _empty),
+                                        _mm256_cmpeq_epi8(_cells, _word))};
+      if (static_cast<uint32_t>(_mm256_movemask_epi8(_ok)) != 0xFFFFFFFF) {
+        return false;
+      }
+    }
+  }
+#endif
+
+#if defined(__SSE2__)
+  {
+    const __m128i _empty{_mm_set1_epi8(p_empty)};
+    for (; _i + 16 <= p_size; _i += 16) {
+      const __m128i _cells{
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_cells + _i))};
+      const __m128i _word{
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_word + _i))};
+      const __m128i _ok{_mm_or_si128(_mm_cmpeq_epi8(_cells, _empty),
+                                     _mm_cmpeq_epi8(_cells, _word))};
+      if (_mm_movemask_epi8(_ok) != 0xFFFF) {
+        return false;
+      }
+    }
+
+    const size_t _remaining{p_size - _i};
+    if (_remaining == 0) {
+      return true;
+    }
+
+    alignas(16) char _cells_tail[16]{};
+    alignas(16) char _word_tail[16]{};
+    std::memcpy(_cells_tail, p_cells + _i, _remaining);
+    std::memcpy(_word_tail, p_word + _i, _remaining);
+
+    const __m128i _cells{
+        _mm_load_si128(reinterpret_cast<const __m128i *>(_cells_tail))};
+    const __m128i _word{
+        _mm_load_si128(reinterpret_cast<const __m128i *>(_word_tail))};
+    const __m128i _ok{_mm_or_si128(_mm_cmpeq_epi8(_cells, _empty),
+                                   _mm_cmpeq_epi8(_cells, _word))};
+    const int _lanes{(1 << _remaining) - 1};
+    return (_mm_movemask_epi8(_ok) & _lanes) == _lanes;
+  }
+#else
+  for (; _i < p_size; ++_i) {
+    if ((p_cells[_i] != p_empty) && (p_cells[_i] != p_word[_i])) {
+      return false;
+    }
+  }
+  return true;
+#endif
+}
+
+/// \brief Same as \p fits, but the tail of the span is compared directly
+/// from memory, with the lanes beyond \p p_size masked out
+///
+/// \pre \p padding bytes after the last cell of the span, and after the last
+/// letter of the word, must be readable
+inline bool fits_padded(const char *p_cells, const char *p_word, size_t p_size,
+                        char p_empty) {
+#if defined(__AVX2__)
+  const __m256i _empty{_mm256_set1_epi8(p_empty)};
+  for (size_t _i = 0; _i < p_size; _i += 32) {
+    const __m256i _cells{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_cells + _i))};
+    const __m256i _word{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_word + _i))};
+    const __m256i _ok{_mm256_or_si256(_mm256_cmpeq_epi8(_cells, _empty),
+                                      _mm256_cmpeq_epi8(_cells, _word))};
+    const size_t _remaining{p_size - _i};
+    const uint32_t _lanes{_remaining >= 32
+                              ? 0xFFFFFFFF
+                              : static_cast<uint32_t>((1u << _remaining) - 1)};
+    if ((static_cast<uint32_t>(_mm256_movemask_epi8(_ok)) & _lanes) != _lanes) {
+      return false;
+    }
+  }
+  return true;
+#elif defined(__SSE2__)
+  const __m128i _empty{_mm_set1_epi8(p_empty)};
+  for (size_t _i = 0; _i < p_size; _i += 16) {
+    const __m128i _cells{
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_cells + _i))};
+    const __m128i _word{
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_word + _i))};
+    const __m128i _ok{_mm_or_si128(_mm_cmpeq_epi8(_cells, _empty),
+                                   _mm_cmpeq_epi8(_cells, _word))};
+    const size_t _remaining{p_size - _i};
+    const int _lanes{_remaining >= 16 ? 0xFFFF
+                                      : static_cast<int>((1 << _remaining) - 1)};
+    if ((_mm_movemask_epi8(_ok) & _lanes) != _lanes) {
+      return false;
+    }
+  }
+  return true;
+#else
+  return fits(p_cells, p_word, p_size, p_empty);
+#endif
+}
+
+/// \brief Maximum number of letters of the words compared in
+/// \p intersections
+static constexpr size_t max_intersection_size{32};
+
+/// \brief Finds which letters of a word are equal to each letter of another
+/// word
+///
+/// \details Each letter of \p p_first is broadcast and compared to all the
+/// letters of \p p_second in one vector compare, 32 lanes with AVX2 or two
+/// times 16 lanes with SSE2, or letter by letter otherwise.
+///
+/// \param p_first first letter of the first word
+///
+/// \param p_first_size number of letters of the first word, at most
+/// \p max_intersection_size
+///
+/// \param p_second first letter of the second word
+///
+/// \param p_second_size number of letters of the second word, at most
+/// \p max_intersection_size
+///
+/// \param p_masks \p p_first_size masks, where bit \p j of \p p_masks[i] is
+/// set if \p p_first[i] is equal to \p p_second[j]
+///
+/// \return \p true if any letter is common to both words
+inline bool intersections(const char *p_first, size_t p_first_size,
+                          const char *p_second, size_t p_second_size,
+                          uint32_t *p_masks) {
+  uint32_t _any{0};
+#if defined(__SSE2__)
+  alignas(32) char _second[max_intersection_size]{};
+  std::memcpy(_second, p_second, p_second_size);
+  const uint32_t _lanes{p_second_size >= 32
+                            ? 0xFFFFFFFF
+                            : static_cast<uint32_t>((1u << p_second_size) - 1)};
+#if defined(__AVX2__)
+  const __m256i _letters{
+      _mm256_load_si256(reinterpret_cast<const __m256i *>(_second))};
+  for (size_t _i = 0; _i < p_first_size; ++_i) {
+    const __m256i _letter{_mm256_set1_epi8(p_first[_i])};
+    p_masks[_i] = static_cast<uint32_t>(_mm256_movemask_epi8(
+                      _mm256_cmpeq_epi8(_letter, _letters))) &
+                  _lanes;
+    _any |= p_masks[_i];
+  }
+#else
+  const __m128i _low{
+      _mm_load_si128(reinterpret_cast<const __m128i *>(_second))};
+  const __m128i _high{
+      _mm_load_si128(reinterpret_cast<const __m128i *>(_second + 16))};
+  for (size_t _i = 0; _i < p_first_size; ++_i) {
+    const __m128i _letter{_mm_set1_epi8(p_first[_i])};
+    p_masks[_i] =
+        (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_letter, _low))) |
+         (static_cast<uint32_t>(
+              _mm_movemask_epi8(_mm_cmpeq_epi8(_letter, _high)))
+          << 16)) &
+        _lanes;
+    _any |= p_masks[_i];
+  }
+#endif
+#else
+  for (size_t _i = 0; _i < p_first_size; ++_i) {
+    p_masks[_i] = 0;
+    for (size_t _j = 0; _j < p_second_size; ++_j) {
+      if (p_first[_i] == p_second[_j]) {
+        p_masks[_i] |= uint32_t{1} << _j;
+      }
+    }
+    _any |= p_masks[_i];
+  }
+#endif
+  return _any != 0;
+}
+
+} // namespace tenacitas::lib::crosswords::typ::simd
+
+#endif
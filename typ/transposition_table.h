@@ -0,0 +1,136 @@
+#ifndef TENACITAS_LIB_CROSSWORDS_TYP_TRANSPOSITION_TABLE_H
+#define TENACITAS_LIB_CROSSWORDS_TYP_TRANSPOSITION_TABLE_H
+
+/// \copyright This file is under GPL 3 license. Please read the \p LICENSE file
+/// at the root of \p tenacitas directory
+
+/// \author Rodrigo Canellas - rodrigo.canellas at gmail.com
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include <tenacitas.lib.crosswords/typ/grid.h>
+
+namespace tenacitas::lib::crosswords::typ {
+
+/// \brief Grids, identified by their Zobrist hash, from which no organization
+/// is possible, shared by the organizers of all the threads
+///
+/// \details The table has a fixed number of buckets, defined by a memory
+/// limit, each one with \p bucket_size entries. An entry keeps the hash of a
+/// grid, and the number of words that were not positioned in it, its depth.
+/// When a bucket is full, the entry with the lowest depth is replaced, if the
+/// new one is not lower, as a grid with more words to position is reached by
+/// more orders of positioning the words.
+///
+/// There are no locks: an entry has two atomic words, the depth and the hash
+/// combined with the depth by an exclusive or, so an entry half written by
+/// one thread while read by another is just not found.
+struct transposition_table {
+  using key = uint64_t;
+  using depth = uint16_t;
+
+  /// \brief Default memory used by the table, 16MB
+  static constexpr size_t default_memory{size_t{16} << 20};
+
+  /// \brief Number of entries where a hash can be kept
+  static constexpr size_t bucket_size{4};
+
+  /// \brief Constructor
+  ///
+  /// \param p_memory maximum number of bytes used by the table; the number of
+  /// buckets is the largest power of 2 that fits, and at least 1
+  transposition_table(size_t p_memory = default_memory) {
+    size_t _buckets{1};
+    while (2 * _buckets * sizeof(bucket) <= p_memory) {
+      _buckets <<= 1;
+    }
+    m_mask = _buckets - 1;
+    m_buckets = std::make_unique<bucket[]>(_buckets);
+  }
+
+  transposition_table(const transposition_table &) = delete;
+  transposition_table(transposition_table &&) = delete;
+  ~transposition_table() = default;
+
+  transposition_table &operator=(const transposition_table &) = delete;
+  transposition_table &operator=(transposition_table &&) = delete;
+
+  /// \brief Records that no organization was found from a grid
+  ///
+  /// \param p_key Zobrist hash of the grid
+  ///
+  /// \param p_depth number of words not positioned in the grid
+  void store(key p_key, depth p_depth) {
+    bucket &_bucket{m_buckets[p_key & m_mask]};
+    const uint64_t _data{(static_cast<uint64_t>(p_depth) << 1) | 1};
+
+    entry *_replace{nullptr};
+    uint64_t _lowest{std::numeric_limits<uint64_t>::max()};
+    for (entry &_entry : _bucket.entries) {
+      const uint64_t _current{_entry.data.load(std::memory_order_relaxed)};
+      if (_current == 0) {
+        _replace = &_entry;
+        break;
+      }
+      if ((_entry.check.load(std::memory_order_relaxed) ^ _current) == p_key) {
+        if (_current >= _data) {
+          return;
+        }
+        _replace = &_entry;
+        break;
+      }
+      if (_current < _lowest) {
+        _lowest = _current;
+        _replace = &_entry;
+      }
+    }
+
+    if (_replace->data.load(std::memory_order_relaxed) > _data) {
+      return;
+    }
+    _replace->check.store(p_key ^ _data, std::memory_order_relaxed);
+    _replace->data.store(_data, std::memory_order_release);
+  }
+
+  /// \brief Informs if no organization was found from a grid
+  ///
+  /// \param p_key Zobrist hash of the grid
+  bool failed(key p_key) const {
+    const bucket &_bucket{m_buckets[p_key & m_mask]};
+    for (const entry &_entry : _bucket.entries) {
+      const uint64_t _data{_entry.data.load(std::memory_order_acquire)};
+      if ((_data != 0) &&
+          ((_entry.check.load(std::memory_order_relaxed) ^ _data) == p_key)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// \brief Number of grids that can be kept
+  inline size_t capacity() const { return (m_mask + 1) * bucket_size; }
+
+private:
+  struct entry {
+    std::atomic<uint64_t> check{0};
+
+    /// \brief Depth shifted one bit to the left, with the lowest bit set, or
+    /// 0 if the entry is empty
+    std::atomic<uint64_t> data{0};
+  };
+
+  struct bucket {
+    entry entries[bucket_size];
+  };
+
+private:
+  size_t m_mask{0};
+  std::unique_ptr<bucket[]> m_buckets;
+};
+
+} // namespace tenacitas::lib::crosswords::typ
+
+#endif